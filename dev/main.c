@@ -15,6 +15,7 @@ extern void test_run(void);
 extern void example_minimal_run(void);
 extern void example_traverse_run(void);
 extern void example_stream_run(void);
+extern void example_parallel_run(void);
 
 /* Trial stream -> for a user to try its own code... */
 extern void trial_stream_run(void);
@@ -40,6 +41,7 @@ main() {
     example_minimal_run();
     example_traverse_run();
     example_stream_run();
+    example_parallel_run();
 #endif
     return 0;
 #endif
@@ -0,0 +1,110 @@
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include "lwjson/lwjson.h"
+
+/*
+ * Parse newline delimited JSON documents on multiple threads.
+ *
+ * Data is split to more chunks than there are threads.
+ * Every thread takes next chunk from shared counter when it is done with previous one,
+ * so that threads with short chunks continue with work of the others.
+ * Each thread has its own LwJSON instance and tokens.
+ */
+
+#define THREADS_CNT 4
+#define CHUNKS_CNT  (THREADS_CNT * 8)
+
+/* Shared job, results are stored per chunk to keep input order */
+typedef struct {
+    const char* data;
+    size_t offsets[CHUNKS_CNT];
+    atomic_size_t next_chunk;
+    size_t docs[CHUNKS_CNT];
+    size_t errors[CHUNKS_CNT];
+    long long id_sum[CHUNKS_CNT];
+} job_t;
+
+/* Worker thread with own LwJSON instance and tokens */
+typedef struct {
+    job_t* job;
+    size_t chunk;
+    pthread_t thread;
+    lwjson_token_t tokens[64];
+    lwjson_t lwjson;
+} worker_t;
+
+/* Called for every document of the chunk */
+static void
+prv_doc_callback(lwjson_t* lwobj, lwjsonr_t res, size_t offset, size_t len, void* user_data) {
+    worker_t* w = user_data;
+    const lwjson_token_t* t;
+
+    (void)offset;
+    (void)len;
+    if (res == lwjsonOK) {
+        ++w->job->docs[w->chunk];
+        if ((t = lwjson_find(lwobj, "id")) != NULL && t->type == LWJSON_TYPE_NUM_INT) {
+            w->job->id_sum[w->chunk] += (long long)lwjson_get_val_int(t);
+        }
+    } else {
+        ++w->job->errors[w->chunk];
+    }
+}
+
+/* Parse chunks until all of them are taken */
+static void*
+prv_worker_thread(void* arg) {
+    worker_t* w = arg;
+    job_t* job = w->job;
+    size_t chunk, start;
+
+    lwjson_init(&w->lwjson, w->tokens, LWJSON_ARRAYSIZE(w->tokens));
+    while ((chunk = atomic_fetch_add(&job->next_chunk, 1)) < CHUNKS_CNT) {
+        start = chunk > 0 ? job->offsets[chunk - 1] : 0;
+        w->chunk = chunk;
+        lwjson_parse_many(&w->lwjson, &job->data[start], job->offsets[chunk] - start, prv_doc_callback, w);
+    }
+    return NULL;
+}
+
+/* Parse NDJSON data */
+void
+example_parallel_run(void) {
+    static job_t job;
+    static worker_t workers[THREADS_CNT];
+    size_t len = 0, docs = 0, errors = 0;
+    long long id_sum = 0;
+    char* data;
+
+    /* Generate input data */
+    data = malloc(10000 * 64);
+    if (data == NULL) {
+        return;
+    }
+    for (int i = 0; i < 10000; ++i) {
+        len += (size_t)sprintf(&data[len], "{\"id\":%d,\"name\":\"item %d\",\"tags\":[1,2,3]}\n", i, i);
+    }
+
+    /* Split to chunks of whole lines and parse them */
+    job.data = data;
+    atomic_init(&job.next_chunk, 0);
+    lwjson_split_many(data, len, job.offsets, CHUNKS_CNT);
+    for (size_t i = 0; i < THREADS_CNT; ++i) {
+        workers[i].job = &job;
+        pthread_create(&workers[i].thread, NULL, prv_worker_thread, &workers[i]);
+    }
+    for (size_t i = 0; i < THREADS_CNT; ++i) {
+        pthread_join(workers[i].thread, NULL);
+    }
+
+    /* Collect results in input order */
+    for (size_t i = 0; i < CHUNKS_CNT; ++i) {
+        docs += job.docs[i];
+        errors += job.errors[i];
+        id_sum += job.id_sum[i];
+    }
+    printf("Documents: %d, errors: %d, sum of IDs: %lld\r\n", (int)docs, (int)errors, id_sum);
+    free(data);
+}
@@ -13,7 +13,7 @@ example_traverse_run(void) {
 
     /* Try to parse input string */
     if (lwjson_parse(&lwjson, "{\"mykey\":\"myvalue\",\"num\":1,\"obj\":{},\"arr\":[1,2,3,4]}") == lwjsonOK) {
-        lwjson_token_t* t;
+        const lwjson_token_t* t;
         printf("JSON parsed..\r\n");
 
         /* Get very first token as top object */
@@ -27,8 +27,11 @@ example_traverse_run(void) {
         }
 
         /* Now print all keys in the object */
-        for (const lwjson_token_t* tkn = lwjson_get_first_child(t); tkn != NULL; tkn = tkn->next) {
-            printf("Token: %.*s", (int)tkn->token_name_len, tkn->token_name);
+        for (const lwjson_token_t* tkn = lwjson_get_first_child(t); tkn != NULL; tkn = lwjson_get_next(tkn)) {
+            size_t name_len;
+            const char* name = lwjson_get_name(&lwjson, tkn, &name_len);
+
+            printf("Token: %.*s", (int)name_len, name);
             if (tkn->type == LWJSON_TYPE_ARRAY || tkn->type == LWJSON_TYPE_OBJECT) {
                 printf(": Token is array or object...check children tokens if any, in recursive mode..");
                 /* Get first child of token */
@@ -18,6 +18,7 @@ set(LWJSON_CUSTOM_INC_DIR ${CMAKE_CURRENT_BINARY_DIR}/lib_inc)
 set(lwjson_core_SRCS
     ${CMAKE_CURRENT_LIST_DIR}/src/lwjson/lwjson.c
     ${CMAKE_CURRENT_LIST_DIR}/src/lwjson/lwjson_stream.c
+    ${CMAKE_CURRENT_LIST_DIR}/src/lwjson/lwjson_file.c
 )
 
 # Debug sources
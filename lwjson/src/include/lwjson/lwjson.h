@@ -55,6 +55,11 @@ extern "C" {
  */
 #define LWJSON_ARRAYSIZE(x) (sizeof(x) / sizeof((x)[0]))
 
+/**
+ * \brief           Number of zero bytes, required after input data of \ref lwjson_parse_padded
+ */
+#define LWJSON_PADDING 64
+
 /**
  * \brief           List of supported JSON types
  */
@@ -67,6 +72,7 @@ typedef enum {
     LWJSON_TYPE_TRUE,     /*!< True boolean value */
     LWJSON_TYPE_FALSE,    /*!< False boolean value */
     LWJSON_TYPE_NULL,     /*!< Null value */
+    LWJSON_TYPE_SKIPPED,  /*!< Array element skipped by selective parsing, keeping position of next elements */
 } lwjson_type_t;
 
 /**
@@ -79,12 +85,54 @@ typedef LWJSON_CFG_REAL_TYPE lwjson_real_t;
  */
 typedef LWJSON_CFG_INT_TYPE lwjson_int_t;
 
+#if LWJSON_CFG_COMPACT_TOKEN
+
+/**
+ * \brief           JSON token, compact format
+ *
+ * Strings are stored as offsets to input data, and tokens are linked implicitly.
+ * Tokens are stored in document order, hence first child of object or array immediately follows its parent,
+ * and next sibling follows all tokens of the subtree.
+ *
+ * Use accessor functions to get names, strings and linked tokens
+ */
+typedef struct lwjson_token {
+    uint32_t token_name_off; /*!< Offset of token name in input data, `0` if token has no name */
+    uint16_t token_name_len; /*!< Length of token name */
+    uint8_t type;            /*!< Token type, member of \ref lwjson_type_t enumeration */
+
+    struct {
+        uint8_t name_escaped : 1;  /*!< Token name contains at least one escape sequence */
+        uint8_t value_escaped : 1; /*!< String value contains at least one escape sequence */
+        uint8_t has_next : 1;      /*!< Token is followed by next sibling */
+    } flags;                       /*!< List of flags */
+
+    union {
+        struct {
+            uint32_t token_value_off; /*!< Offset of the beginning of the string in input data */
+            uint32_t token_value_len; /*!< Length of token value */
+        } str;                        /*!< String data */
+
+        lwjson_real_t num_real; /*!< Real number format */
+        lwjson_int_t num_int;   /*!< Int number format */
+        uint32_t tokens_cnt;    /*!< Number of tokens in the subtree for object or array type */
+    } u;                        /*!< Union with different data types */
+} lwjson_token_t;
+
+#else /* LWJSON_CFG_COMPACT_TOKEN */
+
 /**
  * \brief           JSON token
  */
 typedef struct lwjson_token {
     struct lwjson_token* next; /*!< Next token on a list */
     lwjson_type_t type;        /*!< Token type */
+
+    struct {
+        uint8_t name_escaped : 1;  /*!< Token name contains at least one escape sequence */
+        uint8_t value_escaped : 1; /*!< String value contains at least one escape sequence */
+    } flags;                       /*!< List of flags */
+
     const char* token_name;    /*!< Token name (if exists) */
     size_t token_name_len;     /*!< Length of token name (this is needed to support const input strings to parse) */
 
@@ -93,14 +141,25 @@ typedef struct lwjson_token {
             const char* token_value; /*!< Pointer to the beginning of the string */
             size_t
                 token_value_len; /*!< Length of token value (this is needed to support const input strings to parse) */
-        } str;                   /*!< String data */
+        } str;                   /*!< String data, or number text with \ref LWJSON_CFG_LAZY_NUMBER */
 
         lwjson_real_t num_real;           /*!< Real number format */
         lwjson_int_t num_int;             /*!< Int number format */
         struct lwjson_token* first_child; /*!< First children object for object or array type */
     } u;                                  /*!< Union with different data types */
+
+#if LWJSON_CFG_CHILD_INDEX
+    size_t child_cnt;                  /*!< Number of children for object or array type */
+    struct lwjson_token** child_index; /*!< Table of children for array type, `NULL` if not available */
+#endif                                 /* LWJSON_CFG_CHILD_INDEX */
+#if LWJSON_CFG_KEY_INDEX
+    struct lwjson_token** key_index; /*!< Hash table of children for object type, `NULL` if not available */
+    size_t key_index_len;            /*!< Number of entries in hash table, power of `2` */
+#endif                               /* LWJSON_CFG_KEY_INDEX */
 } lwjson_token_t;
 
+#endif /* !LWJSON_CFG_COMPACT_TOKEN */
+
 /**
  * \brief           JSON result enumeration
  */
@@ -116,8 +175,25 @@ typedef enum {
     lwjsonSTREAMDONE,          /*!< Streaming parser is done,
                                     closing character matched the stream opening one */
     lwjsonSTREAMINPROG,        /*!< Stream parsing is still in progress */
+
+    lwjsonERRNUMRANGE, /*!< Integer number does not fit to \ref lwjson_int_t type */
+    lwjsonODEND,       /*!< On-demand iterator reached end of object or array */
 } lwjsonr_t;
 
+#if LWJSON_CFG_ARENA
+
+/**
+ * \brief           Block of tokens allocated for the arena
+ * \note            Block descriptor is placed in the same allocation, right after the tokens
+ */
+typedef struct lwjson_arena_blk {
+    struct lwjson_arena_blk* next; /*!< Next allocated block */
+    lwjson_token_t* tokens;        /*!< Pointer to tokens of the block */
+    size_t tokens_len;             /*!< Number of tokens in the block */
+} lwjson_arena_blk_t;
+
+#endif /* LWJSON_CFG_ARENA */
+
 /**
  * \brief           LwJSON instance
  */
@@ -125,21 +201,251 @@ typedef struct {
     lwjson_token_t* tokens;     /*!< Pointer to array of tokens */
     size_t tokens_len;          /*!< Size of all tokens */
     size_t next_free_token_pos; /*!< Position of next free token instance */
+#if LWJSON_CFG_ARENA
+    lwjson_arena_blk_t* arena_first; /*!< First allocated block of tokens */
+    lwjson_arena_blk_t* arena_cur;   /*!< Block in use, `NULL` while array of tokens is in use */
+    size_t arena_pos;                /*!< Position of next free token in current block */
+    size_t arena_len;                /*!< Number of tokens in array and all allocated blocks */
+#endif                               /* LWJSON_CFG_ARENA */
+#if LWJSON_CFG_COMPACT_TOKEN
+    const char* json_data; /*!< Parsed input data, token string offsets refer to it */
+#else
     lwjson_token_t first_token; /*!< First token on a list */
+    lwjson_token_t* last_child; /*!< Last child of first token, after \ref lwjson_parse_array_part */
+#endif /* !LWJSON_CFG_COMPACT_TOKEN */
+#if LWJSON_CFG_CHILD_INDEX
+    lwjson_token_t** index;     /*!< Buffer for array children tables */
+    size_t index_len;           /*!< Size of index buffer in units of token pointers */
+    size_t next_free_index_pos; /*!< Position of next free index buffer entry */
+#endif                          /* LWJSON_CFG_CHILD_INDEX */
+#if LWJSON_CFG_KEY_INDEX
+    lwjson_token_t** key_index;     /*!< Buffer for hash tables of object keys */
+    size_t key_index_len;           /*!< Size of key index buffer in units of token pointers */
+    size_t next_free_key_index_pos; /*!< Position of next free key index buffer entry */
+#endif                              /* LWJSON_CFG_KEY_INDEX */
+#if LWJSON_CFG_FILE
+    const void* file_data; /*!< Data of the file mapped by \ref lwjson_parse_file */
+    size_t file_len;       /*!< Length of the mapped file */
+#endif                     /* LWJSON_CFG_FILE */
 
     struct {
-        uint8_t parsed : 1; /*!< Flag indicating JSON parsing has finished successfully */
-    } flags;                /*!< List of flags */
+        uint8_t parsed : 1;   /*!< Flag indicating JSON parsing has finished successfully */
+        uint8_t part_sep : 1; /*!< Chunk of root array starts with comma, that follows elements of previous chunks */
+    } flags;                  /*!< List of flags */
 } lwjson_t;
 
+/**
+ * \brief           Segment type of compiled path
+ */
+typedef enum {
+    LWJSON_PATH_KEY,   /*!< Key of object member */
+    LWJSON_PATH_INDEX, /*!< Array element at index, `#N` segment */
+    LWJSON_PATH_ANY,   /*!< Any array element, `#` segment */
+} lwjson_path_type_t;
+
+/**
+ * \brief           Segment of compiled path
+ */
+typedef struct {
+    const char* name; /*!< Key name, pointing to the path string */
+    size_t name_len;  /*!< Length of key name */
+    size_t index;     /*!< Array index for \ref LWJSON_PATH_INDEX type */
+    uint32_t hash;    /*!< Hash of key name */
+    uint8_t type;     /*!< Segment type, member of \ref lwjson_path_type_t enumeration */
+} lwjson_path_segment_t;
+
+/**
+ * \brief           Compiled path for \ref lwjson_find_compiled
+ */
+typedef struct {
+    lwjson_path_segment_t segments[LWJSON_CFG_PATH_MAX_SEGMENTS]; /*!< Path segments */
+    size_t segments_cnt;                                          /*!< Number of used segments */
+} lwjson_path_t;
+
+#if LWJSON_CFG_QUERY
+
+/**
+ * \brief           Segment type of compiled query
+ */
+typedef enum {
+    LWJSON_QUERY_KEY,      /*!< Key of object member, `.name` or `['name']` segment */
+    LWJSON_QUERY_INDEX,    /*!< Array element at index, `[N]` segment, negative index counts from the end */
+    LWJSON_QUERY_SLICE,    /*!< Array elements in range, `[start:end:step]` segment */
+    LWJSON_QUERY_WILDCARD, /*!< Any object member or array element, `.*` or `[*]` segment */
+} lwjson_query_type_t;
+
+/**
+ * \brief           Segment of compiled query
+ */
+typedef struct {
+    const char* name;   /*!< Key name, pointing to the query string */
+    size_t name_len;    /*!< Length of key name */
+    int32_t start;      /*!< Array index or first index of the slice */
+    int32_t end;        /*!< End index of the slice, not included */
+    int32_t step;       /*!< Step of the slice */
+    uint8_t type;       /*!< Segment type, member of \ref lwjson_query_type_t enumeration */
+    uint8_t descendant; /*!< Set to `1` when segment matches at any depth, `..` prefix */
+} lwjson_query_segment_t;
+
+/**
+ * \brief           Compiled query for \ref lwjson_query
+ */
+typedef struct {
+    lwjson_query_segment_t segments[LWJSON_CFG_PATH_MAX_SEGMENTS]; /*!< Query segments */
+    size_t segments_cnt;                                           /*!< Number of used segments */
+} lwjson_query_t;
+
+#endif /* LWJSON_CFG_QUERY */
+
+/**
+ * \brief           Callback function for every document parsed with \ref lwjson_parse_many
+ * \param[in]       lwobj: LwJSON instance with parsed document, when `res` is \ref lwjsonOK
+ * \param[in]       res: Parse result of the document
+ * \param[in]       offset: Offset of the document from the beginning of input data
+ * \param[in]       len: Length of the document in units of bytes
+ * \param[in]       user_data: User data, as passed to \ref lwjson_parse_many
+ */
+typedef void (*lwjson_parse_many_callback_fn)(lwjson_t* lwobj, lwjsonr_t res, size_t offset, size_t len,
+                                              void* user_data);
+
+#if LWJSON_CFG_QUERY
+
+/**
+ * \brief           Callback function for every token matched with \ref lwjson_query
+ * \param[in]       lwobj: LwJSON instance
+ * \param[in]       token: Matched token
+ * \param[in]       user_data: User data, as passed to \ref lwjson_query
+ */
+typedef void (*lwjson_query_callback_fn)(lwjson_t* lwobj, const lwjson_token_t* token, void* user_data);
+
+#endif /* LWJSON_CFG_QUERY */
+
 lwjsonr_t lwjson_init(lwjson_t* lwobj, lwjson_token_t* tokens, size_t tokens_len);
+#if LWJSON_CFG_CHILD_INDEX
+lwjsonr_t lwjson_set_index(lwjson_t* lwobj, lwjson_token_t** index, size_t index_len);
+#endif /* LWJSON_CFG_CHILD_INDEX */
+#if LWJSON_CFG_KEY_INDEX
+lwjsonr_t lwjson_set_key_index(lwjson_t* lwobj, lwjson_token_t** index, size_t index_len);
+#endif /* LWJSON_CFG_KEY_INDEX */
 lwjsonr_t lwjson_parse_ex(lwjson_t* lwobj, const void* json_data, size_t len);
 lwjsonr_t lwjson_parse(lwjson_t* lwobj, const char* json_str);
+#if LWJSON_CFG_SELECTIVE
+lwjsonr_t lwjson_parse_selective(lwjson_t* lwobj, const void* json_data, size_t json_len, const lwjson_path_t* paths,
+                                 size_t paths_cnt);
+#endif /* LWJSON_CFG_SELECTIVE */
+#if LWJSON_CFG_INSITU
+lwjsonr_t lwjson_parse_insitu(lwjson_t* lwobj, char* json_data, size_t json_len);
+#endif /* LWJSON_CFG_INSITU */
+lwjsonr_t lwjson_parse_padded(lwjson_t* lwobj, const void* json_data, size_t json_len);
+lwjsonr_t lwjson_parse_many(lwjson_t* lwobj, const void* json_data, size_t json_len,
+                            lwjson_parse_many_callback_fn evt_fn, void* user_data);
+lwjsonr_t lwjson_split_many(const void* json_data, size_t json_len, size_t* offsets, size_t offsets_len);
+lwjsonr_t lwjson_split_array(const void* json_data, size_t json_len, size_t* offsets, size_t offsets_len);
+#if !LWJSON_CFG_COMPACT_TOKEN
+lwjsonr_t lwjson_parse_array_part(lwjson_t* lwobj, const void* json_data, size_t json_len);
+lwjsonr_t lwjson_join_array(lwjson_t* lwobj, lwjson_t* parts, size_t parts_cnt);
+#endif /* !LWJSON_CFG_COMPACT_TOKEN */
+size_t lwjson_count_tokens(const void* json_data, size_t len);
+#if LWJSON_CFG_FILE
+lwjsonr_t lwjson_parse_file(lwjson_t* lwobj, const char* path);
+lwjsonr_t lwjson_file_map(const char* path, const void** data, size_t* len);
+lwjsonr_t lwjson_file_unmap(const void* data, size_t len);
+#endif /* LWJSON_CFG_FILE */
 const lwjson_token_t* lwjson_find(lwjson_t* lwobj, const char* path);
 const lwjson_token_t* lwjson_find_ex(lwjson_t* lwobj, const lwjson_token_t* token, const char* path);
+lwjsonr_t lwjson_path_compile(const char* path, lwjson_path_t* compiled);
+const lwjson_token_t* lwjson_find_compiled(lwjson_t* lwobj, const lwjson_token_t* token, const lwjson_path_t* compiled);
+lwjsonr_t lwjson_find_many(lwjson_t* lwobj, const lwjson_path_t* paths, size_t paths_cnt,
+                           const lwjson_token_t** results);
+const lwjson_token_t* lwjson_find_pointer(lwjson_t* lwobj, const lwjson_token_t* token, const char* pointer);
+#if LWJSON_CFG_QUERY
+lwjsonr_t lwjson_query_compile(const char* query, lwjson_query_t* compiled);
+lwjsonr_t lwjson_query(lwjson_t* lwobj, const lwjson_token_t* token, const lwjson_query_t* query,
+                       lwjson_query_callback_fn evt_fn, void* user_data);
+#endif /* LWJSON_CFG_QUERY */
+const char* lwjson_get_val_string_decoded(const lwjson_t* lwobj, const lwjson_token_t* token, char* buf, size_t buf_len,
+                                          size_t* str_len);
+uint8_t lwjson_string_compare_decoded(const lwjson_t* lwobj, const lwjson_token_t* token, const char* str, size_t len);
+lwjsonr_t lwjson_reset(lwjson_t* lwobj);
 lwjsonr_t lwjson_free(lwjson_t* lwobj);
+#if LWJSON_CFG_ARENA
+lwjsonr_t lwjson_arena_release(lwjson_t* lwobj);
+#endif /* LWJSON_CFG_ARENA */
+
+#if LWJSON_CFG_TAPE
+
+/**
+ * \brief           Tape word, values are stored as one or more words in depth-first order
+ */
+typedef uint64_t lwjson_tape_word_t;
 
+/**
+ * \brief           LwJSON tape instance
+ */
+typedef struct {
+    lwjson_tape_word_t* tape; /*!< Pointer to array of tape words */
+    size_t tape_len;          /*!< Size of tape in units of words */
+    size_t tape_used;         /*!< Number of used tape words */
+    const char* json_data;    /*!< Parsed input data, string offsets in the tape refer to it */
+
+    struct {
+        uint8_t parsed : 1; /*!< Flag indicating JSON parsing has finished successfully */
+    } flags;                /*!< List of flags */
+} lwjson_tape_t;
+
+lwjsonr_t lwjson_tape_init(lwjson_tape_t* tobj, lwjson_tape_word_t* tape, size_t tape_len);
+lwjsonr_t lwjson_tape_parse_ex(lwjson_tape_t* tobj, const void* json_data, size_t len);
+lwjsonr_t lwjson_tape_parse(lwjson_tape_t* tobj, const char* json_str);
+const lwjson_tape_word_t* lwjson_tape_find(const lwjson_tape_t* tobj, const char* path);
+const lwjson_tape_word_t* lwjson_tape_find_ex(const lwjson_tape_t* tobj, const lwjson_tape_word_t* w,
+                                              const char* path);
+const lwjson_tape_word_t* lwjson_tape_get_root(const lwjson_tape_t* tobj);
+const lwjson_tape_word_t* lwjson_tape_get_first_child(const lwjson_tape_word_t* w);
+const lwjson_tape_word_t* lwjson_tape_get_next(const lwjson_tape_word_t* w);
+lwjson_type_t lwjson_tape_get_type(const lwjson_tape_word_t* w);
+const char* lwjson_tape_get_name(const lwjson_tape_t* tobj, const lwjson_tape_word_t* w, size_t* name_len);
+const char* lwjson_tape_get_val_string(const lwjson_tape_t* tobj, const lwjson_tape_word_t* w, size_t* str_len);
+lwjson_int_t lwjson_tape_get_val_int(const lwjson_tape_word_t* w);
+lwjson_real_t lwjson_tape_get_val_real(const lwjson_tape_word_t* w);
+
+#endif /* LWJSON_CFG_TAPE */
+
+#if LWJSON_CFG_ON_DEMAND
+
+/**
+ * \brief           On-demand iterator, walks JSON data without tokens
+ */
+typedef struct {
+    const char* json_data;                         /*!< JSON data to iterate */
+    size_t len;                                    /*!< Length of JSON data */
+    size_t pos;                                    /*!< Current position in JSON data */
+    uint8_t stack[LWJSON_CFG_ON_DEMAND_MAX_DEPTH]; /*!< Types of entered objects and arrays */
+    uint8_t depth;                                 /*!< Number of entered objects and arrays */
+
+    struct {
+        uint8_t pending : 1; /*!< Iterator is at the value that was not consumed yet */
+        uint8_t first : 1;   /*!< Iterator is before first element of object or array */
+        uint8_t error : 1;   /*!< JSON format error was detected, iterator cannot be used anymore */
+    } flags;                                       /*!< List of flags */
+} lwjson_od_t;
+
+lwjsonr_t lwjson_od_init(lwjson_od_t* od, const void* json_data, size_t len);
+lwjsonr_t lwjson_od_get_type(const lwjson_od_t* od, lwjson_type_t* type);
+lwjsonr_t lwjson_od_enter(lwjson_od_t* od);
+lwjsonr_t lwjson_od_next(lwjson_od_t* od, const char** name, size_t* name_len);
+lwjsonr_t lwjson_od_find_field(lwjson_od_t* od, const char* name);
+lwjsonr_t lwjson_od_skip(lwjson_od_t* od);
+lwjsonr_t lwjson_od_exit(lwjson_od_t* od);
+lwjsonr_t lwjson_od_get_int(lwjson_od_t* od, lwjson_int_t* val);
+lwjsonr_t lwjson_od_get_real(lwjson_od_t* od, lwjson_real_t* val);
+lwjsonr_t lwjson_od_get_string(lwjson_od_t* od, const char** str, size_t* str_len);
+lwjsonr_t lwjson_od_get_bool(lwjson_od_t* od, uint8_t* val);
+
+#endif /* LWJSON_CFG_ON_DEMAND */
+
+#if !LWJSON_CFG_COMPACT_TOKEN
 void lwjson_print_token(const lwjson_token_t* token);
+#endif /* !LWJSON_CFG_COMPACT_TOKEN */
 void lwjson_print_json(const lwjson_t* lwobj);
 
 /**
@@ -212,6 +518,11 @@ typedef struct lwjson_stream_parser {
             size_t buff_pos;       /*!< Buffer position for next write (length of bytes in buffer) */
             size_t buff_total_pos; /*!< Total buffer position used up to now (in several data chunks) */
             uint8_t is_last;       /*!< Status indicates if this is the last part of the string */
+#if LWJSON_CFG_VALIDATE_UTF8
+            uint8_t utf8_cont; /*!< Number of UTF-8 continuation bytes still expected */
+            uint8_t utf8_lo;   /*!< Lowest valid value of the next continuation byte */
+            uint8_t utf8_hi;   /*!< Highest valid value of the next continuation byte */
+#endif                         /* LWJSON_CFG_VALIDATE_UTF8 */
         } str;                     /*!< String structure. It is only used for keys and string objects.
                                         Use primitive part for all other options */
 
@@ -231,36 +542,107 @@ lwjsonr_t lwjson_stream_set_user_data(lwjson_stream_parser_t* jsp, void* user_da
 void* lwjson_stream_get_user_data(lwjson_stream_parser_t* jsp);
 lwjsonr_t lwjson_stream_reset(lwjson_stream_parser_t* jsp);
 lwjsonr_t lwjson_stream_parse(lwjson_stream_parser_t* jsp, char c);
+#if LWJSON_CFG_FILE
+lwjsonr_t lwjson_stream_parse_file(lwjson_stream_parser_t* jsp, const char* path);
+#endif /* LWJSON_CFG_FILE */
+
+#if LWJSON_CFG_COMPACT_TOKEN
 
 /**
  * \brief           Get number of tokens used to parse JSON
+ * \note            Compact format stores first token in the array of tokens
  * \param[in]       lwobj: Pointer to LwJSON instance
  * \return          Number of tokens used to parse JSON
  */
-#define lwjson_get_tokens_used(lwobj) (((lwobj) != NULL) ? ((lwobj)->next_free_token_pos + 1) : 0)
+#define lwjson_get_tokens_used(lwobj) (((lwobj) != NULL) ? ((lwobj)->next_free_token_pos) : 0)
 
 /**
  * \brief           Get very first token of LwJSON instance
  * \param[in]       lwobj: Pointer to LwJSON instance
  * \return          Pointer to first token
  */
-#define lwjson_get_first_token(lwobj) (((lwobj) != NULL) ? (&(lwobj)->first_token) : NULL)
+#define lwjson_get_first_token(lwobj) (((lwobj) != NULL) ? ((const lwjson_token_t*)(lwobj)->tokens) : NULL)
 
 /**
- * \brief           Get token value for \ref LWJSON_TYPE_NUM_INT type
+ * \brief           Get first child token for \ref LWJSON_TYPE_OBJECT or \ref LWJSON_TYPE_ARRAY types
  * \param[in]       token: token with integer type
- * \return          Int number if type is integer, `0` otherwise
+ * \return          Pointer to first child or `NULL` if parent token is not object or array
  */
-#define lwjson_get_val_int(token)                                                                                      \
-    ((lwjson_int_t)(((token) != NULL && (token)->type == LWJSON_TYPE_NUM_INT) ? (token)->u.num_int : 0))
+#define lwjson_get_first_child(token)                                                                                  \
+    (const void*)(((token) != NULL && ((token)->type == LWJSON_TYPE_OBJECT || (token)->type == LWJSON_TYPE_ARRAY)      \
+                   && (token)->u.tokens_cnt > 0)                                                                       \
+                      ? (token) + 1                                                                                    \
+                      : NULL)
 
 /**
- * \brief           Get token value for \ref LWJSON_TYPE_NUM_REAL type
- * \param[in]       token: token with real type
- * \return          Real numbeer if type is real, `0` otherwise
+ * \brief           Get next sibling token
+ * \param[in]       token: Token to get sibling for
+ * \return          Pointer to next token in the same object or array or `NULL` if token is the last one
  */
-#define lwjson_get_val_real(token)                                                                                     \
-    ((lwjson_real_t)(((token) != NULL && (token)->type == LWJSON_TYPE_NUM_REAL) ? (token)->u.num_real : 0))
+static inline const lwjson_token_t*
+lwjson_get_next(const lwjson_token_t* token) {
+    if (token == NULL || !token->flags.has_next) {
+        return NULL;
+    }
+    if (token->type == LWJSON_TYPE_OBJECT || token->type == LWJSON_TYPE_ARRAY) {
+        return token + 1 + token->u.tokens_cnt;
+    }
+    return token + 1;
+}
+
+/**
+ * \brief           Get name of the token
+ * \param[in]       lwobj: LwJSON instance used to parse the token
+ * \param[in]       token: Token to get name for
+ * \param[out]      name_len: Pointer to variable holding length of name.
+ *                      Set to `NULL` if not used
+ * \return          Pointer to name or `NULL` if token has no name
+ */
+static inline const char*
+lwjson_get_name(const lwjson_t* lwobj, const lwjson_token_t* token, size_t* name_len) {
+    if (token != NULL && token->token_name_off > 0) {
+        if (name_len != NULL) {
+            *name_len = token->token_name_len;
+        }
+        return lwobj->json_data + token->token_name_off;
+    }
+    return NULL;
+}
+
+/**
+ * \brief           Get string value from JSON token
+ * \param[in]       lwobj: LwJSON instance used to parse the token
+ * \param[in]       token: Token with string type
+ * \param[out]      str_len: Pointer to variable holding length of string.
+ *                      Set to `NULL` if not used
+ * \return          Pointer to string or `NULL` if invalid token type
+ */
+static inline const char*
+lwjson_get_val_string_ex(const lwjson_t* lwobj, const lwjson_token_t* token, size_t* str_len) {
+    if (token != NULL && token->type == LWJSON_TYPE_STRING) {
+        if (str_len != NULL) {
+            *str_len = token->u.str.token_value_len;
+        }
+        return lwobj->json_data + token->u.str.token_value_off;
+    }
+    return NULL;
+}
+
+#else /* LWJSON_CFG_COMPACT_TOKEN */
+
+/**
+ * \brief           Get number of tokens used to parse JSON
+ * \param[in]       lwobj: Pointer to LwJSON instance
+ * \return          Number of tokens used to parse JSON
+ */
+#define lwjson_get_tokens_used(lwobj) (((lwobj) != NULL) ? ((lwobj)->next_free_token_pos + 1) : 0)
+
+/**
+ * \brief           Get very first token of LwJSON instance
+ * \param[in]       lwobj: Pointer to LwJSON instance
+ * \return          Pointer to first token
+ */
+#define lwjson_get_first_token(lwobj) (((lwobj) != NULL) ? (&(lwobj)->first_token) : NULL)
 
 /**
  * \brief           Get first child token for \ref LWJSON_TYPE_OBJECT or \ref LWJSON_TYPE_ARRAY types
@@ -272,6 +654,33 @@ lwjsonr_t lwjson_stream_parse(lwjson_stream_parser_t* jsp, char c);
                       ? (token)->u.first_child                                                                         \
                       : NULL)
 
+/**
+ * \brief           Get next sibling token
+ * \param[in]       token: Token to get sibling for
+ * \return          Pointer to next token in the same object or array or `NULL` if token is the last one
+ */
+#define lwjson_get_next(token) ((const lwjson_token_t*)((token) != NULL ? (token)->next : NULL))
+
+/**
+ * \brief           Get name of the token
+ * \param[in]       lwobj: LwJSON instance used to parse the token. Not used, kept for compact token format
+ * \param[in]       token: Token to get name for
+ * \param[out]      name_len: Pointer to variable holding length of name.
+ *                      Set to `NULL` if not used
+ * \return          Pointer to name or `NULL` if token has no name
+ */
+static inline const char*
+lwjson_get_name(const lwjson_t* lwobj, const lwjson_token_t* token, size_t* name_len) {
+    (void)lwobj;
+    if (token != NULL && token->token_name != NULL) {
+        if (name_len != NULL) {
+            *name_len = token->token_name_len;
+        }
+        return token->token_name;
+    }
+    return NULL;
+}
+
 /**
  * \brief           Get string value from JSON token
  * \param[in]       token: Token with string type
@@ -290,6 +699,57 @@ lwjson_get_val_string(const lwjson_token_t* token, size_t* str_len) {
     return NULL;
 }
 
+/**
+ * \brief           Get string value from JSON token
+ * \param[in]       lwobj: LwJSON instance used to parse the token. Not used, kept for compact token format
+ * \param[in]       token: Token with string type
+ * \param[out]      str_len: Pointer to variable holding length of string.
+ *                      Set to `NULL` if not used
+ * \return          Pointer to string or `NULL` if invalid token type
+ */
+#define lwjson_get_val_string_ex(lwobj, token, str_len) ((void)(lwobj), lwjson_get_val_string((token), (str_len)))
+
+#endif /* !LWJSON_CFG_COMPACT_TOKEN */
+
+#if LWJSON_CFG_LAZY_NUMBER
+
+lwjson_int_t lwjson_get_val_int(const lwjson_token_t* token);
+lwjson_real_t lwjson_get_val_real(const lwjson_token_t* token);
+
+#else /* LWJSON_CFG_LAZY_NUMBER */
+
+/**
+ * \brief           Get token value for \ref LWJSON_TYPE_NUM_INT type
+ * \param[in]       token: token with integer type
+ * \return          Int number if type is integer, `0` otherwise
+ */
+#define lwjson_get_val_int(token)                                                                                      \
+    ((lwjson_int_t)(((token) != NULL && (token)->type == LWJSON_TYPE_NUM_INT) ? (token)->u.num_int : 0))
+
+/**
+ * \brief           Get token value for \ref LWJSON_TYPE_NUM_REAL type
+ * \param[in]       token: token with real type
+ * \return          Real numbeer if type is real, `0` otherwise
+ */
+#define lwjson_get_val_real(token)                                                                                     \
+    ((lwjson_real_t)(((token) != NULL && (token)->type == LWJSON_TYPE_NUM_REAL) ? (token)->u.num_real : 0))
+
+#endif /* !LWJSON_CFG_LAZY_NUMBER */
+
+#if LWJSON_CFG_CHILD_INDEX
+
+/**
+ * \brief           Get number of children for \ref LWJSON_TYPE_OBJECT or \ref LWJSON_TYPE_ARRAY types
+ * \param[in]       token: token with object or array type
+ * \return          Number of children or `0` if token is not object or array
+ */
+#define lwjson_get_child_count(token)                                                                                  \
+    ((size_t)(((token) != NULL && ((token)->type == LWJSON_TYPE_OBJECT || (token)->type == LWJSON_TYPE_ARRAY))         \
+                  ? (token)->child_cnt                                                                                 \
+                  : 0))
+
+#endif /* LWJSON_CFG_CHILD_INDEX */
+
 /**
  * \brief           Get length of string for \ref LWJSON_TYPE_STRING token type
  * \param[in]       token: token with string type
@@ -298,35 +758,73 @@ lwjson_get_val_string(const lwjson_token_t* token, size_t* str_len) {
 #define lwjson_get_val_string_length(token)                                                                            \
     ((size_t)(((token) != NULL && (token)->type == LWJSON_TYPE_STRING) ? (token)->u.str.token_value_len : 0))
 
+/**
+ * \brief           Check if \ref LWJSON_TYPE_STRING token value contains escape sequences
+ * \note            Value without escape sequences can be used as-is, no decoding is necessary
+ * \param[in]       token: token with string type
+ * \return          `1` if string value contains at least one escape sequence, `0` otherwise
+ */
+#define lwjson_get_val_string_escaped(token)                                                                           \
+    ((uint8_t)(((token) != NULL && (token)->type == LWJSON_TYPE_STRING) ? (token)->flags.value_escaped : 0))
+
 /**
  * \brief           Compare string token with user input string for a case-sensitive match
+ * \param[in]       lwobj: LwJSON instance used to parse the token
  * \param[in]       token: Token with string type
  * \param[in]       str: NULL-terminated string to compare
  * \return          `1` if equal, `0` otherwise
  */
 static inline uint8_t
-lwjson_string_compare(const lwjson_token_t* token, const char* str) {
+lwjson_string_compare_ex(const lwjson_t* lwobj, const lwjson_token_t* token, const char* str) {
     if (token != NULL && token->type == LWJSON_TYPE_STRING) {
-        return strncmp(token->u.str.token_value, str, token->u.str.token_value_len) == 0;
+        return strncmp(lwjson_get_val_string_ex(lwobj, token, NULL), str, token->u.str.token_value_len) == 0;
     }
     return 0;
 }
 
 /**
  * \brief           Compare string token with user input string for a case-sensitive match
+ * \param[in]       lwobj: LwJSON instance used to parse the token
  * \param[in]       token: Token with string type
  * \param[in]       str: NULL-terminated string to compare
  * \param[in]       len: Length of the string in bytes
  * \return          `1` if equal, `0` otherwise
  */
 static inline uint8_t
-lwjson_string_compare_n(const lwjson_token_t* token, const char* str, size_t len) {
+lwjson_string_compare_n_ex(const lwjson_t* lwobj, const lwjson_token_t* token, const char* str, size_t len) {
     if (token != NULL && token->type == LWJSON_TYPE_STRING && len <= token->u.str.token_value_len) {
-        return strncmp(token->u.str.token_value, str, len) == 0;
+        return strncmp(lwjson_get_val_string_ex(lwobj, token, NULL), str, len) == 0;
     }
     return 0;
 }
 
+#if !LWJSON_CFG_COMPACT_TOKEN
+
+/**
+ * \brief           Compare string token with user input string for a case-sensitive match
+ * \param[in]       token: Token with string type
+ * \param[in]       str: NULL-terminated string to compare
+ * \return          `1` if equal, `0` otherwise
+ */
+static inline uint8_t
+lwjson_string_compare(const lwjson_token_t* token, const char* str) {
+    return lwjson_string_compare_ex(NULL, token, str);
+}
+
+/**
+ * \brief           Compare string token with user input string for a case-sensitive match
+ * \param[in]       token: Token with string type
+ * \param[in]       str: NULL-terminated string to compare
+ * \param[in]       len: Length of the string in bytes
+ * \return          `1` if equal, `0` otherwise
+ */
+static inline uint8_t
+lwjson_string_compare_n(const lwjson_token_t* token, const char* str, size_t len) {
+    return lwjson_string_compare_n_ex(NULL, token, str, len);
+}
+
+#endif /* !LWJSON_CFG_COMPACT_TOKEN */
+
 /**
  * \name            LWJSON_STREAM_SEQ
  * \brief           Helper functions for stack analysis in a callback function
@@ -72,6 +72,24 @@ extern "C" {
 #define LWJSON_CFG_INT_TYPE long long
 #endif
 
+/**
+ * \brief           Enables `1` or disables `0` correctly rounded conversion of real numbers
+ *
+ * When enabled, real numbers are converted with Eisel-Lemire algorithm,
+ * using table of `128`-bit approximations of powers of ten.
+ * Rare numbers that cannot be decided by the algorithm are converted with `strtof` or `strtod` C library function.
+ * It is effective when \ref LWJSON_CFG_REAL_TYPE is `float` or `double`.
+ *
+ * When disabled, significand is scaled with small table of powers of ten.
+ * Result is correctly rounded only when significand and power of ten are both exact in the real type,
+ * which is up to `15` digits and exponents up to `22` for `double` type.
+ *
+ * \note            Table of powers of ten uses `~10kB` of read-only memory
+ */
+#ifndef LWJSON_CFG_REAL_EXACT
+#define LWJSON_CFG_REAL_EXACT 0
+#endif
+
 /**
  * \brief           Enables `1` or disables `0` support for inline comments
  *
@@ -81,6 +99,237 @@ extern "C" {
 #define LWJSON_CFG_COMMENTS 0
 #endif
 
+/**
+ * \brief           Enables `1` or disables `0` use of SIMD instructions in the parser
+ *
+ * When enabled and compiler targets a CPU with `SSE2` or `AVX2` instruction set,
+ * vector kernels are used to classify input characters and to scan string bodies
+ * `16` or `32` bytes at a time. Scalar code is used otherwise, producing exactly the same result.
+ */
+#ifndef LWJSON_CFG_SIMD
+#define LWJSON_CFG_SIMD 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` two-stage parsing with structural index
+ *
+ * When enabled, input is first classified in blocks of `64` bytes into bitmaps
+ * of blank, quote, backslash and structural characters.
+ * Parser then jumps over blank runs and string bodies using the bitmaps,
+ * instead of checking input character by character.
+ *
+ * \note            Bitmaps are built lazily, one block at a time, hence no additional memory is needed
+ */
+#ifndef LWJSON_CFG_STRUCT_INDEX
+#define LWJSON_CFG_STRUCT_INDEX 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` UTF-8 validation of property names and string values
+ *
+ * When enabled, parser and stream parser reject strings that are not well-formed UTF-8
+ * (overlong forms, surrogates, code points above `U+10FFFF` or truncated sequences) with \ref lwjsonERRJSON.
+ * With \ref LWJSON_CFG_SIMD and `AVX2`, non-ASCII strings are validated `32` bytes at a time with lookup tables,
+ * and with \ref LWJSON_CFG_STRUCT_INDEX, ASCII-only strings are recognized from block bitmaps.
+ */
+#ifndef LWJSON_CFG_VALIDATE_UTF8
+#define LWJSON_CFG_VALIDATE_UTF8 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` child count and direct access index of array children
+ *
+ * When enabled, every object and array token counts its children
+ * and arrays get table of pointers to children, allocated from user buffer set with \ref lwjson_set_index.
+ * Access with `#N` path segment is then done in constant time, instead of walking the list of children.
+ *
+ * Arrays are left without table if there is no more space in the buffer, and are searched the old way.
+ */
+#ifndef LWJSON_CFG_CHILD_INDEX
+#define LWJSON_CFG_CHILD_INDEX 0
+#endif
+
+/**
+ * \brief           Minimal number of array children to allocate direct access index table for them
+ *
+ * Short arrays are fast enough to walk and are not worth buffer space.
+ * It is used only when \ref LWJSON_CFG_CHILD_INDEX is enabled.
+ */
+#ifndef LWJSON_CFG_CHILD_INDEX_MIN_CNT
+#define LWJSON_CFG_CHILD_INDEX_MIN_CNT 8
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` hash index of object keys
+ *
+ * When enabled, objects with many children get hash table of children by their names,
+ * allocated from user buffer set with \ref lwjson_set_key_index when object is parsed.
+ * Key lookup in \ref lwjson_find and \ref lwjson_find_ex is then done in constant time,
+ * instead of comparing names of all children.
+ *
+ * Objects are left without table if there is no more space in the buffer, and are searched the old way.
+ */
+#ifndef LWJSON_CFG_KEY_INDEX
+#define LWJSON_CFG_KEY_INDEX 0
+#endif
+
+/**
+ * \brief           Minimal number of object children to build hash table of keys for them
+ *
+ * Small objects are fast enough to scan and are not worth buffer space.
+ * Table size is power of `2` number, at least twice as large as number of children.
+ * It is used only when \ref LWJSON_CFG_KEY_INDEX is enabled.
+ */
+#ifndef LWJSON_CFG_KEY_INDEX_MIN_CNT
+#define LWJSON_CFG_KEY_INDEX_MIN_CNT 16
+#endif
+
+/**
+ * \brief           Max number of segments in path compiled with \ref lwjson_path_compile
+ *
+ * Every segment uses one entry in \ref lwjson_path_t structure
+ */
+#ifndef LWJSON_CFG_PATH_MAX_SEGMENTS
+#define LWJSON_CFG_PATH_MAX_SEGMENTS 8
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` selective parsing
+ *
+ * With \ref lwjson_parse_selective, tokens are created only for values on selected paths,
+ * while all other values are skipped without tokens
+ */
+#ifndef LWJSON_CFG_SELECTIVE
+#define LWJSON_CFG_SELECTIVE 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` in-situ parsing of writable input data
+ *
+ * With \ref lwjson_parse_insitu, escape sequences of property names and string values
+ * are decoded in place of input data, and every name and string value is `NULL`-terminated
+ */
+#ifndef LWJSON_CFG_INSITU
+#define LWJSON_CFG_INSITU 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` query engine with wildcards, recursive descent and array slices
+ *
+ * Queries are compiled with \ref lwjson_query_compile
+ * and all matching tokens are reported with \ref lwjson_query in single walk of the tree
+ */
+#ifndef LWJSON_CFG_QUERY
+#define LWJSON_CFG_QUERY 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` compact token format
+ *
+ * When enabled, token uses `16` bytes on any platform, instead of `48` bytes on 64-bit systems.
+ * Names and strings are stored as `32`-bit offsets to input data
+ * and tokens are linked implicitly by their position in the array of tokens.
+ * Very first token is stored in the array of tokens too.
+ *
+ * Names and strings must be accessed with functions, that take LwJSON instance as parameter,
+ * such as \ref lwjson_get_name and \ref lwjson_get_val_string_ex,
+ * and tokens must be linked with \ref lwjson_get_first_child and \ref lwjson_get_next.
+ *
+ * \note            Input data is limited to `4 GB` and names to `65535` bytes.
+ *                  Parse functions return \ref lwjsonERRPAR for longer input or names.
+ *                  \ref LWJSON_CFG_REAL_TYPE and \ref LWJSON_CFG_INT_TYPE must not be larger than `8` bytes
+ */
+#ifndef LWJSON_CFG_COMPACT_TOKEN
+#define LWJSON_CFG_COMPACT_TOKEN 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` growable arena of tokens
+ *
+ * When enabled, tokens are taken from the array set with \ref lwjson_init first,
+ * and then from blocks allocated with \ref LWJSON_MALLOC when array is full.
+ * Every new block is as large as all tokens before it, so that number of allocations
+ * grows logarithmically with the size of JSON data.
+ *
+ * Blocks are kept for the next parse operations, until \ref lwjson_arena_release is called.
+ * Array of tokens for \ref lwjson_init may be `NULL`, to only use allocated blocks.
+ */
+#ifndef LWJSON_CFG_ARENA
+#define LWJSON_CFG_ARENA 0
+#endif
+
+/**
+ * \brief           Number of tokens in the first allocated block of the arena
+ *
+ * It is used only when \ref LWJSON_CFG_ARENA is enabled.
+ */
+#ifndef LWJSON_CFG_ARENA_MIN_BLOCK
+#define LWJSON_CFG_ARENA_MIN_BLOCK 64
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` parsing of files mapped to memory
+ *
+ * When enabled, \ref lwjson_parse_file maps the file read-only to memory and parses it in place,
+ * without copying it to a buffer. Tokens refer directly to the mapped data,
+ * which stays mapped until \ref lwjson_free is called or next file is parsed.
+ *
+ * \note            It requires POSIX `mmap` support from the operating system
+ */
+#ifndef LWJSON_CFG_FILE
+#define LWJSON_CFG_FILE 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` lazy conversion of numbers
+ *
+ * When enabled, parser only validates numbers and keeps their text in the token.
+ * Text is converted to number in \ref lwjson_get_val_int and \ref lwjson_get_val_real functions,
+ * which is faster when only few numbers of the document are read by the application.
+ *
+ * Token type is still set to \ref LWJSON_TYPE_NUM_INT or \ref LWJSON_TYPE_NUM_REAL,
+ * and integer numbers out of range are still reported at parse time.
+ *
+ * \note            Number is converted on every function call, input data must stay valid while tokens are used
+ */
+#ifndef LWJSON_CFG_LAZY_NUMBER
+#define LWJSON_CFG_LAZY_NUMBER 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` tape output format
+ *
+ * Tape is an alternative parse target to the tree of tokens, see \ref lwjson_tape_parse.
+ * It is a flat array of `64`-bit words, with values stored in depth-first order.
+ * Object and array start words hold size of the subtree, so that whole subtree is skipped in one step,
+ * and traversal goes sequentially through memory.
+ *
+ * Keys, strings and numbers use `2` words, literals use `1` word, objects and arrays use `2` words.
+ */
+#ifndef LWJSON_CFG_TAPE
+#define LWJSON_CFG_TAPE 0
+#endif
+
+/**
+ * \brief           Enables `1` or disables `0` on-demand iterator
+ *
+ * On-demand iterator walks JSON data directly, without array of tokens, see \ref lwjson_od_init.
+ * Application enters objects and arrays, finds fields and reads values in document order,
+ * while the rest of the data is only validated and skipped.
+ */
+#ifndef LWJSON_CFG_ON_DEMAND
+#define LWJSON_CFG_ON_DEMAND 0
+#endif
+
+/**
+ * \brief           Max depth of nested objects and arrays for on-demand iterator
+ *
+ * Every level uses `1` byte in \ref lwjson_od_t structure
+ */
+#ifndef LWJSON_CFG_ON_DEMAND_MAX_DEPTH
+#define LWJSON_CFG_ON_DEMAND_MAX_DEPTH 32
+#endif
+
 /**
  * \brief           Memory set function
  * 
@@ -99,6 +348,24 @@ extern "C" {
 #define LWJSON_MEMCPY(dst, src, len) memcpy((dst), (src), (len))
 #endif
 
+/**
+ * \brief           Memory allocation function, used by \ref LWJSON_CFG_ARENA
+ * 
+ * \note            Function footprint is the same as \ref malloc
+ */
+#ifndef LWJSON_MALLOC
+#define LWJSON_MALLOC(size) malloc(size)
+#endif
+
+/**
+ * \brief           Memory free function, used by \ref LWJSON_CFG_ARENA
+ * 
+ * \note            Function footprint is the same as \ref free
+ */
+#ifndef LWJSON_FREE
+#define LWJSON_FREE(ptr) free(ptr)
+#endif
+
 /**
  * \defgroup        LWJSON_OPT_STREAM JSON stream
  * \brief           JSON streaming confiuration
@@ -146,6 +413,26 @@ extern "C" {
  * \}
  */
 
+#if LWJSON_CFG_COMPACT_TOKEN && LWJSON_CFG_CHILD_INDEX
+#error "LWJSON_CFG_CHILD_INDEX cannot be used with LWJSON_CFG_COMPACT_TOKEN"
+#endif /* LWJSON_CFG_COMPACT_TOKEN && LWJSON_CFG_CHILD_INDEX */
+
+#if LWJSON_CFG_COMPACT_TOKEN && LWJSON_CFG_LAZY_NUMBER
+#error "LWJSON_CFG_LAZY_NUMBER cannot be used with LWJSON_CFG_COMPACT_TOKEN"
+#endif /* LWJSON_CFG_COMPACT_TOKEN && LWJSON_CFG_LAZY_NUMBER */
+
+#if LWJSON_CFG_COMPACT_TOKEN && LWJSON_CFG_KEY_INDEX
+#error "LWJSON_CFG_KEY_INDEX cannot be used with LWJSON_CFG_COMPACT_TOKEN"
+#endif /* LWJSON_CFG_COMPACT_TOKEN && LWJSON_CFG_KEY_INDEX */
+
+#if LWJSON_CFG_COMPACT_TOKEN && LWJSON_CFG_ARENA
+#error "LWJSON_CFG_ARENA cannot be used with LWJSON_CFG_COMPACT_TOKEN"
+#endif /* LWJSON_CFG_COMPACT_TOKEN && LWJSON_CFG_ARENA */
+
+#if LWJSON_CFG_QUERY && LWJSON_CFG_PATH_MAX_SEGMENTS > 63
+#error "LWJSON_CFG_PATH_MAX_SEGMENTS cannot be larger than 63 with LWJSON_CFG_QUERY"
+#endif /* LWJSON_CFG_QUERY && LWJSON_CFG_PATH_MAX_SEGMENTS > 63 */
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
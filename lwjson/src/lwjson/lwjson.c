@@ -34,15 +34,409 @@
 #include <string.h>
 #include "lwjson/lwjson.h"
 
+#if LWJSON_CFG_REAL_EXACT || LWJSON_CFG_ARENA
+#include <stdlib.h>
+#endif /* LWJSON_CFG_REAL_EXACT || LWJSON_CFG_ARENA */
+#if LWJSON_CFG_REAL_EXACT
+#include "lwjson_pow10_tbl.h"
+#endif /* LWJSON_CFG_REAL_EXACT */
+
+#if LWJSON_CFG_SIMD && defined(__AVX2__)
+#include <immintrin.h>
+#define LWJSON_USE_AVX2 1
+#elif LWJSON_CFG_SIMD && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#include <emmintrin.h>
+#define LWJSON_USE_SSE2 1
+#endif
+
+#if LWJSON_CFG_STRUCT_INDEX
+
+/* Size of single classification block in units of bytes */
+#define LWJSON_BLK_SIZE 64
+
+/* Character classes for scalar classification */
+#define LWJSON_CC_BLANK  0x01
+#define LWJSON_CC_QUOTE  0x02
+#define LWJSON_CC_BSLASH 0x04
+#define LWJSON_CC_OP     0x08
+
+/**
+ * \brief           Classification bitmaps of one input block
+ * Bit `n` of each mask corresponds to byte `n` of the block
+ */
+typedef struct {
+    size_t pos;      /*!< Offset of the block from the beginning of input, or `SIZE_MAX` when not set */
+    uint64_t blank;  /*!< Blank characters as per RFC4627 */
+    uint64_t quote;  /*!< Double quote characters */
+    uint64_t bslash; /*!< Backslash characters */
+    uint64_t op;     /*!< Structural characters `{`, `}`, `[`, `]`, `:` and `,` */
+#if LWJSON_CFG_VALIDATE_UTF8
+    uint64_t high; /*!< Non-ASCII bytes, with the most significant bit set */
+#endif             /* LWJSON_CFG_VALIDATE_UTF8 */
+} lwjson_int_blk_t;
+#endif /* LWJSON_CFG_STRUCT_INDEX */
+
 /**
  * \brief           Internal string object
  */
 typedef struct {
     const char* start; /*!< Original pointer to beginning of JSON object */
     size_t len;        /*!< Total length of input json string */
+    size_t readable;   /*!< Number of bytes from the beginning, available to multi-byte loads */
     const char* p;     /*!< Current char pointer */
+#if LWJSON_CFG_STRUCT_INDEX
+    lwjson_int_blk_t blk; /*!< Bitmaps of the most recently classified block */
+#endif /* LWJSON_CFG_STRUCT_INDEX */
+#if LWJSON_CFG_INSITU
+    uint8_t insitu; /*!< Set to `1` to decode names and string values in place of input data */
+#endif /* LWJSON_CFG_INSITU */
+#if LWJSON_CFG_VALIDATE_UTF8
+    uint64_t high; /*!< Non-zero when string being parsed has at least one non-ASCII byte */
+#endif             /* LWJSON_CFG_VALIDATE_UTF8 */
 } lwjson_int_str_t;
 
+/**
+ * \brief           Context of selective parsing
+ *
+ * Every container on the way to selected paths has bit mask of paths, still matching at its depth.
+ * Containers deeper than \ref LWJSON_CFG_PATH_MAX_SEGMENTS are always parsed with all children.
+ */
+typedef struct {
+    const lwjson_path_t* paths;                   /*!< Array of selected paths */
+    uint64_t masks[LWJSON_CFG_PATH_MAX_SEGMENTS]; /*!< Bit mask of paths matching container at depth */
+    size_t pos[LWJSON_CFG_PATH_MAX_SEGMENTS];     /*!< Position of next element of array at depth */
+    size_t depth;                                 /*!< Depth of current container, root is at `0` */
+    size_t keep_depth;                            /*!< Depth of container parsed with all children, or `SIZE_MAX` */
+    uint64_t sub;                                 /*!< Bit mask of paths continuing in selected value */
+    uint8_t is_all;                               /*!< Set to `1` when selected value is parsed with all children */
+} lwjson_int_select_t;
+
+/**
+ * \brief           Get number of trailing zero bits
+ * \param[in]       x: Value to check. Must not be `0`
+ * \return          Index of the least significant set bit
+ */
+static inline uint32_t
+prv_ctz64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint32_t)__builtin_ctzll(x);
+#else
+    uint32_t n = 0;
+    for (; (x & 0x01) == 0; x >>= 1, ++n) {}
+    return n;
+#endif
+}
+
+#if LWJSON_CFG_STRUCT_INDEX
+
+#if !LWJSON_USE_AVX2 && !LWJSON_USE_SSE2
+/* Scalar character class table */
+static const uint8_t prv_char_class[256] = {
+    ['\t'] = LWJSON_CC_BLANK, ['\n'] = LWJSON_CC_BLANK,  ['\f'] = LWJSON_CC_BLANK, ['\r'] = LWJSON_CC_BLANK,
+    [' '] = LWJSON_CC_BLANK,  ['"'] = LWJSON_CC_QUOTE,   ['\\'] = LWJSON_CC_BSLASH, ['{'] = LWJSON_CC_OP,
+    ['}'] = LWJSON_CC_OP,     ['['] = LWJSON_CC_OP,      [']'] = LWJSON_CC_OP,     [':'] = LWJSON_CC_OP,
+    [','] = LWJSON_CC_OP,
+};
+#endif /* !LWJSON_USE_AVX2 && !LWJSON_USE_SSE2 */
+
+/**
+ * \brief           Classify `64` bytes of input into block bitmaps
+ * \param[out]      blk: Block to write bitmaps to
+ * \param[in]       d: Pointer to data, at least \ref LWJSON_BLK_SIZE bytes long
+ */
+static void
+prv_blk_classify(lwjson_int_blk_t* blk, const char* d) {
+#if LWJSON_USE_AVX2
+    blk->blank = blk->quote = blk->bslash = blk->op = 0;
+#if LWJSON_CFG_VALIDATE_UTF8
+    blk->high = 0;
+#endif /* LWJSON_CFG_VALIDATE_UTF8 */
+    for (size_t i = 0; i < LWJSON_BLK_SIZE; i += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(const void*)(d + i));
+        __m256i lc = _mm256_or_si256(v, _mm256_set1_epi8(0x20)); /* Maps '[' to '{' and ']' to '}' */
+        __m256i blank, op;
+
+        blank = _mm256_cmpeq_epi8(v, _mm256_set1_epi8(' '));
+        blank = _mm256_or_si256(blank, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\t')));
+        blank = _mm256_or_si256(blank, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\n')));
+        blank = _mm256_or_si256(blank, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\r')));
+        blank = _mm256_or_si256(blank, _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\f')));
+        op = _mm256_cmpeq_epi8(lc, _mm256_set1_epi8('{'));
+        op = _mm256_or_si256(op, _mm256_cmpeq_epi8(lc, _mm256_set1_epi8('}')));
+        op = _mm256_or_si256(op, _mm256_cmpeq_epi8(v, _mm256_set1_epi8(':')));
+        op = _mm256_or_si256(op, _mm256_cmpeq_epi8(v, _mm256_set1_epi8(',')));
+
+        blk->blank |= (uint64_t)(uint32_t)_mm256_movemask_epi8(blank) << i;
+        blk->quote |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('"'))) << i;
+        blk->bslash |= (uint64_t)(uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\'))) << i;
+        blk->op |= (uint64_t)(uint32_t)_mm256_movemask_epi8(op) << i;
+#if LWJSON_CFG_VALIDATE_UTF8
+        blk->high |= (uint64_t)(uint32_t)_mm256_movemask_epi8(v) << i;
+#endif /* LWJSON_CFG_VALIDATE_UTF8 */
+    }
+#elif LWJSON_USE_SSE2
+    blk->blank = blk->quote = blk->bslash = blk->op = 0;
+#if LWJSON_CFG_VALIDATE_UTF8
+    blk->high = 0;
+#endif /* LWJSON_CFG_VALIDATE_UTF8 */
+    for (size_t i = 0; i < LWJSON_BLK_SIZE; i += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(const void*)(d + i));
+        __m128i lc = _mm_or_si128(v, _mm_set1_epi8(0x20)); /* Maps '[' to '{' and ']' to '}' */
+        __m128i blank, op;
+
+        blank = _mm_cmpeq_epi8(v, _mm_set1_epi8(' '));
+        blank = _mm_or_si128(blank, _mm_cmpeq_epi8(v, _mm_set1_epi8('\t')));
+        blank = _mm_or_si128(blank, _mm_cmpeq_epi8(v, _mm_set1_epi8('\n')));
+        blank = _mm_or_si128(blank, _mm_cmpeq_epi8(v, _mm_set1_epi8('\r')));
+        blank = _mm_or_si128(blank, _mm_cmpeq_epi8(v, _mm_set1_epi8('\f')));
+        op = _mm_cmpeq_epi8(lc, _mm_set1_epi8('{'));
+        op = _mm_or_si128(op, _mm_cmpeq_epi8(lc, _mm_set1_epi8('}')));
+        op = _mm_or_si128(op, _mm_cmpeq_epi8(v, _mm_set1_epi8(':')));
+        op = _mm_or_si128(op, _mm_cmpeq_epi8(v, _mm_set1_epi8(',')));
+
+        blk->blank |= (uint64_t)(uint16_t)_mm_movemask_epi8(blank) << i;
+        blk->quote |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('"'))) << i;
+        blk->bslash |= (uint64_t)(uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('\\'))) << i;
+        blk->op |= (uint64_t)(uint16_t)_mm_movemask_epi8(op) << i;
+#if LWJSON_CFG_VALIDATE_UTF8
+        blk->high |= (uint64_t)(uint16_t)_mm_movemask_epi8(v) << i;
+#endif /* LWJSON_CFG_VALIDATE_UTF8 */
+    }
+#else
+    uint64_t blank = 0, quote = 0, bslash = 0, op = 0, high = 0;
+
+    for (size_t i = 0; i < LWJSON_BLK_SIZE; ++i) {
+        uint8_t cc = prv_char_class[(uint8_t)d[i]];
+        high |= (uint64_t)((uint8_t)d[i] >> 7) << i;
+        if (cc != 0) {
+            uint64_t bit = (uint64_t)1 << i;
+            blank |= (cc & LWJSON_CC_BLANK) ? bit : 0;
+            quote |= (cc & LWJSON_CC_QUOTE) ? bit : 0;
+            bslash |= (cc & LWJSON_CC_BSLASH) ? bit : 0;
+            op |= (cc & LWJSON_CC_OP) ? bit : 0;
+        }
+    }
+    blk->blank = blank;
+    blk->quote = quote;
+    blk->bslash = bslash;
+    blk->op = op;
+#if LWJSON_CFG_VALIDATE_UTF8
+    blk->high = high;
+#else
+    (void)high;
+#endif /* !LWJSON_CFG_VALIDATE_UTF8 */
+#endif
+}
+
+/**
+ * \brief           Make sure bitmaps of the block containing input offset are available
+ * \param[in,out]   pobj: JSON string
+ * \param[in]       pos: Offset from the beginning of input. Must be smaller than input length
+ */
+static void
+prv_blk_update(lwjson_int_str_t* pobj, size_t pos) {
+    pos &= ~(size_t)(LWJSON_BLK_SIZE - 1);
+    if (pos == pobj->blk.pos) {
+        return;
+    }
+    if (pos + LWJSON_BLK_SIZE <= pobj->readable) {
+        prv_blk_classify(&pobj->blk, &pobj->start[pos]);
+    } else {
+        /* Last block is copied to zero-padded buffer, padding has no class */
+        char tmp[LWJSON_BLK_SIZE] = {0};
+        LWJSON_MEMCPY(tmp, &pobj->start[pos], pobj->len - pos);
+        prv_blk_classify(&pobj->blk, tmp);
+    }
+    pobj->blk.pos = pos;
+}
+
+/**
+ * \brief           Move current pointer to the first non-blank character, or to the end of input
+ * \param[in,out]   pobj: JSON string
+ */
+static void
+prv_blk_skip_blank(lwjson_int_str_t* pobj) {
+    size_t pos = (size_t)(pobj->p - pobj->start);
+
+    while (pos < pobj->len) {
+        uint64_t mask;
+
+        prv_blk_update(pobj, pos);
+        mask = ~pobj->blk.blank >> (pos & (LWJSON_BLK_SIZE - 1));
+        if (mask != 0) {
+            pos += prv_ctz64(mask);
+            break;
+        }
+        pos = pobj->blk.pos + LWJSON_BLK_SIZE;
+    }
+    pobj->p = &pobj->start[pos < pobj->len ? pos : pobj->len];
+}
+
+/**
+ * \brief           Move current pointer to the first quote or backslash character, or to the end of input
+ * \param[in,out]   pobj: JSON string
+ * \return          Number of characters skipped
+ */
+static size_t
+prv_blk_skip_string_chars(lwjson_int_str_t* pobj) {
+    size_t start_pos, pos;
+
+    start_pos = pos = (size_t)(pobj->p - pobj->start);
+    while (pos < pobj->len) {
+        uint64_t mask;
+
+        prv_blk_update(pobj, pos);
+        mask = (pobj->blk.quote | pobj->blk.bslash) >> (pos & (LWJSON_BLK_SIZE - 1));
+#if LWJSON_CFG_VALIDATE_UTF8
+        /* Non-ASCII bytes of the string are known from the same block, before the stop character */
+        pobj->high |= (pobj->blk.high >> (pos & (LWJSON_BLK_SIZE - 1))) & (mask ^ (mask - 1)) & ~mask;
+#endif /* LWJSON_CFG_VALIDATE_UTF8 */
+        if (mask != 0) {
+            pos += prv_ctz64(mask);
+            break;
+        }
+        pos = pobj->blk.pos + LWJSON_BLK_SIZE;
+    }
+    if (pos > pobj->len) {
+        pos = pobj->len;
+    }
+    pobj->p = &pobj->start[pos];
+    return pos - start_pos;
+}
+
+#if LWJSON_CFG_SELECTIVE && !LWJSON_CFG_COMMENTS
+
+/**
+ * \brief           Move current pointer to the first quote or bracket character, or to the end of input
+ * \param[in,out]   pobj: JSON string
+ */
+static void
+prv_blk_skip_to_bracket(lwjson_int_str_t* pobj) {
+    size_t pos = (size_t)(pobj->p - pobj->start);
+
+    while (pos < pobj->len) {
+        uint64_t mask;
+
+        prv_blk_update(pobj, pos);
+
+        /* Structural characters include separators, that do not change the depth */
+        for (mask = (pobj->blk.quote | pobj->blk.op) & (UINT64_MAX << (pos & (LWJSON_BLK_SIZE - 1))); mask != 0;
+             mask &= mask - 1) {
+            char ch = pobj->start[pobj->blk.pos + prv_ctz64(mask)];
+
+            if (ch != ',' && ch != ':') {
+                break;
+            }
+        }
+        if (mask != 0) {
+            pos = pobj->blk.pos + prv_ctz64(mask);
+            break;
+        }
+        pos = pobj->blk.pos + LWJSON_BLK_SIZE;
+    }
+    pobj->p = &pobj->start[pos < pobj->len ? pos : pobj->len];
+}
+
+#endif /* LWJSON_CFG_SELECTIVE && !LWJSON_CFG_COMMENTS */
+#elif LWJSON_USE_AVX2 || LWJSON_USE_SSE2
+
+/**
+ * \brief           Move current pointer over string characters that need no attention.
+ * Pointer is moved to the first quote or backslash character found in full vectors,
+ * remaining characters are left to the caller
+ * \param[in,out]   pobj: JSON string
+ * \return          Number of characters skipped
+ */
+static size_t
+prv_vec_skip_string_chars(lwjson_int_str_t* pobj) {
+    size_t start_pos, pos;
+
+    start_pos = pos = (size_t)(pobj->p - pobj->start);
+#if LWJSON_USE_AVX2
+    for (; pos + 32 <= pobj->readable; pos += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(const void*)&pobj->start[pos]);
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(
+            _mm256_or_si256(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('"')), _mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\'))));
+#if LWJSON_CFG_VALIDATE_UTF8
+        pobj->high |= (uint32_t)_mm256_movemask_epi8(v) & (mask ^ (mask - 1)) & ~mask;
+#endif /* LWJSON_CFG_VALIDATE_UTF8 */
+        if (mask != 0) {
+            pos += prv_ctz64(mask);
+            break;
+        }
+    }
+#else
+    for (; pos + 16 <= pobj->readable; pos += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(const void*)&pobj->start[pos]);
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(
+            _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('"')), _mm_cmpeq_epi8(v, _mm_set1_epi8('\\'))));
+#if LWJSON_CFG_VALIDATE_UTF8
+        pobj->high |= (uint32_t)_mm_movemask_epi8(v) & (mask ^ (mask - 1)) & ~mask;
+#endif /* LWJSON_CFG_VALIDATE_UTF8 */
+        if (mask != 0) {
+            pos += prv_ctz64(mask);
+            break;
+        }
+    }
+#endif /* LWJSON_USE_AVX2 */
+    if (pos > pobj->len) {
+        pos = pobj->len;
+    }
+    pobj->p = &pobj->start[pos];
+    return pos - start_pos;
+}
+#endif /* LWJSON_CFG_STRUCT_INDEX */
+
+#if LWJSON_CFG_ARENA
+
+/**
+ * \brief           Allocate new token from the arena, when array of tokens is full
+ *
+ * Blocks kept from previous parse operations are used first.
+ * New block is as large as all tokens before it, at least \ref LWJSON_CFG_ARENA_MIN_BLOCK
+ *
+ * \param[in]       lwobj: LwJSON instance
+ * \return          Pointer to new token
+ */
+static lwjson_token_t*
+prv_arena_alloc_token(lwjson_t* lwobj) {
+    lwjson_arena_blk_t* blk = lwobj->arena_cur;
+    lwjson_token_t* t;
+
+    if (blk == NULL || lwobj->arena_pos == blk->tokens_len) {
+        blk = blk == NULL ? lwobj->arena_first : blk->next;
+        if (blk == NULL) {
+            size_t len = lwobj->arena_len > LWJSON_CFG_ARENA_MIN_BLOCK ? lwobj->arena_len : LWJSON_CFG_ARENA_MIN_BLOCK;
+
+            if (len > (SIZE_MAX - sizeof(*blk)) / sizeof(*t)) {
+                return NULL;
+            }
+            t = LWJSON_MALLOC(len * sizeof(*t) + sizeof(*blk));
+            if (t == NULL) {
+                return NULL;
+            }
+            blk = (lwjson_arena_blk_t*)&t[len];
+            blk->next = NULL;
+            blk->tokens = t;
+            blk->tokens_len = len;
+            if (lwobj->arena_cur == NULL) {
+                lwobj->arena_first = blk;
+            } else {
+                lwobj->arena_cur->next = blk;
+            }
+            lwobj->arena_len += len;
+        }
+        lwobj->arena_cur = blk;
+        lwobj->arena_pos = 0;
+    }
+    t = &blk->tokens[lwobj->arena_pos++];
+    ++lwobj->next_free_token_pos;
+    LWJSON_MEMSET(t, 0x00, sizeof(*t));
+    return t;
+}
+
+#endif /* LWJSON_CFG_ARENA */
+
 /**
  * \brief           Allocate new token for JSON block
  * \param[in]       lwobj: LwJSON instance
@@ -54,7 +448,70 @@ prv_alloc_token(lwjson_t* lwobj) {
         LWJSON_MEMSET(&lwobj->tokens[lwobj->next_free_token_pos], 0x00, sizeof(*lwobj->tokens));
         return &lwobj->tokens[lwobj->next_free_token_pos++];
     }
+#if LWJSON_CFG_ARENA
+    return prv_arena_alloc_token(lwobj);
+#else
     return NULL;
+#endif /* !LWJSON_CFG_ARENA */
+}
+
+/**
+ * \brief           Prepare internal string object for parsing
+ * \param[in,out]   pobj: String object with start and length of input data set
+ */
+static void
+prv_str_init(lwjson_int_str_t* pobj) {
+    /*
+     * Input ends at first NUL character.
+     * Multi-byte loads (vectors, bitmaps, digit groups) never reach beyond it, and do not need to check for it
+     */
+    const char* nul = memchr(pobj->start, '\0', pobj->len);
+    if (nul != NULL) {
+        pobj->len = (size_t)(nul - pobj->start);
+    }
+    pobj->readable = pobj->len;
+    pobj->p = pobj->start;
+#if LWJSON_CFG_STRUCT_INDEX
+    pobj->blk.pos = SIZE_MAX;
+#endif /* LWJSON_CFG_STRUCT_INDEX */
+}
+
+/**
+ * \brief           Check if current pointer reached the end of input
+ * \param[in]       pobj: JSON string
+ * \return          `1` at the end of input, `0` otherwise
+ */
+static inline uint8_t
+prv_str_is_end(const lwjson_int_str_t* pobj) {
+    return (size_t)(pobj->p - pobj->start) >= pobj->len;
+}
+
+/**
+ * \brief           Get character at offset from current pointer, or `\0` after the end of input
+ *
+ * Padded input is followed by zero bytes, that are read without the length check.
+ *
+ * \param[in]       pobj: JSON string
+ * \param[in]       off: Offset from current pointer
+ * \return          Character at the offset
+ */
+static inline char
+prv_str_peek(const lwjson_int_str_t* pobj, size_t off) {
+    if (pobj->readable > pobj->len || (size_t)(pobj->p - pobj->start) + off < pobj->len) {
+        return pobj->p[off];
+    }
+    return '\0';
+}
+
+/**
+ * \brief           Check if input has at least `cnt` characters from current pointer
+ * \param[in]       pobj: JSON string
+ * \param[in]       cnt: Number of characters
+ * \return          `1` if characters are available, `0` otherwise
+ */
+static inline uint8_t
+prv_str_has(const lwjson_int_str_t* pobj, size_t cnt) {
+    return (size_t)(pobj->p - pobj->start) + cnt <= pobj->len;
 }
 
 /**
@@ -64,22 +521,23 @@ prv_alloc_token(lwjson_t* lwobj) {
  */
 static lwjsonr_t
 prv_skip_blank(lwjson_int_str_t* pobj) {
-    while (pobj->p != NULL && *pobj->p != '\0' && (size_t)(pobj->p - pobj->start) < pobj->len) {
+    while (!prv_str_is_end(pobj)) {
         if (*pobj->p == ' ' || *pobj->p == '\t' || *pobj->p == '\r' || *pobj->p == '\n' || *pobj->p == '\f') {
+#if LWJSON_CFG_STRUCT_INDEX
+            prv_blk_skip_blank(pobj);
+#else
             ++pobj->p;
+#endif /* LWJSON_CFG_STRUCT_INDEX */
 #if LWJSON_CFG_COMMENTS
             /* Check for comments and remove them */
         } else if (*pobj->p == '/') {
             ++pobj->p;
-            if (pobj->p != NULL && *pobj->p == '*') {
+            if (prv_str_peek(pobj, 0) == '*') {
                 ++pobj->p;
-                while (pobj->p != NULL && *pobj->p != '\0' && (size_t)(pobj->p - pobj->start) < pobj->len) {
-                    if (*pobj->p == '*') {
-                        ++pobj->p;
-                        if (*pobj->p == '/') {
-                            ++pobj->p;
-                            break;
-                        }
+                while (!prv_str_is_end(pobj)) {
+                    if (*pobj->p == '*' && prv_str_peek(pobj, 1) == '/') {
+                        pobj->p += 2;
+                        break;
                     }
                     ++pobj->p;
                 }
@@ -89,24 +547,238 @@ prv_skip_blank(lwjson_int_str_t* pobj) {
             break;
         }
     }
-    if (pobj->p != NULL && *pobj->p != '\0' && (size_t)(pobj->p - pobj->start) < pobj->len) {
+    if (!prv_str_is_end(pobj)) {
         return lwjsonOK;
     }
     return lwjsonERRJSON;
 }
 
+#if LWJSON_CFG_VALIDATE_UTF8
+
+/**
+ * \brief           Get number of characters until the first non-ASCII byte
+ * \param[in]       s: String to check
+ * \param[in]       len: Length of string
+ * \return          Position of the first byte with the most significant bit set, or `len` if there is none
+ */
+static size_t
+prv_ascii_len(const char* s, size_t len) {
+    size_t pos = 0;
+
+#if LWJSON_USE_AVX2
+    for (; pos + 32 <= len; pos += 32) {
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_loadu_si256((const __m256i*)(const void*)&s[pos]));
+        if (mask != 0) {
+            return pos + prv_ctz64(mask);
+        }
+    }
+#elif LWJSON_USE_SSE2
+    for (; pos + 16 <= len; pos += 16) {
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)(const void*)&s[pos]));
+        if (mask != 0) {
+            return pos + prv_ctz64(mask);
+        }
+    }
+#endif /* LWJSON_USE_AVX2 */
+    for (; pos + 8 <= len; pos += 8) {
+        uint64_t w;
+
+        LWJSON_MEMCPY(&w, &s[pos], sizeof(w));
+        if ((w & 0x8080808080808080ULL) != 0) {
+            break;
+        }
+    }
+    for (; pos < len && (uint8_t)s[pos] < 0x80; ++pos) {}
+    return pos;
+}
+
+#if LWJSON_USE_AVX2
+
+/* Error bits of the lookup tables, set when two consecutive bytes cannot follow each other */
+#define LWJSON_U8_TOO_SHORT  0x01 /* Leading byte followed by leading byte or ASCII */
+#define LWJSON_U8_TOO_LONG   0x02 /* ASCII followed by continuation byte */
+#define LWJSON_U8_OVERLONG_3 0x04
+#define LWJSON_U8_TOO_LARGE  0x08
+#define LWJSON_U8_SURROGATE  0x10
+#define LWJSON_U8_OVERLONG_2 0x20
+#define LWJSON_U8_TOO_LARGE2 0x40 /* Also overlong 4-byte form */
+#define LWJSON_U8_TWO_CONTS  0x80 /* Two continuation bytes, valid only in 3 and 4 byte sequences */
+#define LWJSON_U8_CARRY      (LWJSON_U8_TOO_SHORT | LWJSON_U8_TOO_LONG | LWJSON_U8_TWO_CONTS)
+
+/* Errors by high nibble of the first byte, low nibble of the first byte, and high nibble of the second byte */
+static const uint8_t prv_u8_tbl[3][16] = {
+    {
+        LWJSON_U8_TOO_LONG,
+        LWJSON_U8_TOO_LONG,
+        LWJSON_U8_TOO_LONG,
+        LWJSON_U8_TOO_LONG,
+        LWJSON_U8_TOO_LONG,
+        LWJSON_U8_TOO_LONG,
+        LWJSON_U8_TOO_LONG,
+        LWJSON_U8_TOO_LONG,
+        LWJSON_U8_TWO_CONTS,
+        LWJSON_U8_TWO_CONTS,
+        LWJSON_U8_TWO_CONTS,
+        LWJSON_U8_TWO_CONTS,
+        LWJSON_U8_TOO_SHORT | LWJSON_U8_OVERLONG_2,
+        LWJSON_U8_TOO_SHORT,
+        LWJSON_U8_TOO_SHORT | LWJSON_U8_OVERLONG_3 | LWJSON_U8_SURROGATE,
+        LWJSON_U8_TOO_SHORT | LWJSON_U8_TOO_LARGE | LWJSON_U8_TOO_LARGE2,
+    },
+    {
+        LWJSON_U8_CARRY | LWJSON_U8_OVERLONG_3 | LWJSON_U8_OVERLONG_2 | LWJSON_U8_TOO_LARGE2,
+        LWJSON_U8_CARRY | LWJSON_U8_OVERLONG_2,
+        LWJSON_U8_CARRY,
+        LWJSON_U8_CARRY,
+        LWJSON_U8_CARRY | LWJSON_U8_TOO_LARGE,
+        LWJSON_U8_CARRY | LWJSON_U8_TOO_LARGE | LWJSON_U8_TOO_LARGE2,
+        LWJSON_U8_CARRY | LWJSON_U8_TOO_LARGE | LWJSON_U8_TOO_LARGE2,
+        LWJSON_U8_CARRY | LWJSON_U8_TOO_LARGE | LWJSON_U8_TOO_LARGE2,
+        LWJSON_U8_CARRY | LWJSON_U8_TOO_LARGE | LWJSON_U8_TOO_LARGE2,
+        LWJSON_U8_CARRY | LWJSON_U8_TOO_LARGE | LWJSON_U8_TOO_LARGE2,
+        LWJSON_U8_CARRY | LWJSON_U8_TOO_LARGE | LWJSON_U8_TOO_LARGE2,
+        LWJSON_U8_CARRY | LWJSON_U8_TOO_LARGE | LWJSON_U8_TOO_LARGE2,
+        LWJSON_U8_CARRY | LWJSON_U8_TOO_LARGE | LWJSON_U8_TOO_LARGE2,
+        LWJSON_U8_CARRY | LWJSON_U8_TOO_LARGE | LWJSON_U8_TOO_LARGE2 | LWJSON_U8_SURROGATE,
+        LWJSON_U8_CARRY | LWJSON_U8_TOO_LARGE | LWJSON_U8_TOO_LARGE2,
+        LWJSON_U8_CARRY | LWJSON_U8_TOO_LARGE | LWJSON_U8_TOO_LARGE2,
+    },
+    {
+        LWJSON_U8_TOO_SHORT,
+        LWJSON_U8_TOO_SHORT,
+        LWJSON_U8_TOO_SHORT,
+        LWJSON_U8_TOO_SHORT,
+        LWJSON_U8_TOO_SHORT,
+        LWJSON_U8_TOO_SHORT,
+        LWJSON_U8_TOO_SHORT,
+        LWJSON_U8_TOO_SHORT,
+        LWJSON_U8_TOO_LONG | LWJSON_U8_OVERLONG_2 | LWJSON_U8_TWO_CONTS | LWJSON_U8_OVERLONG_3 | LWJSON_U8_TOO_LARGE2,
+        LWJSON_U8_TOO_LONG | LWJSON_U8_OVERLONG_2 | LWJSON_U8_TWO_CONTS | LWJSON_U8_OVERLONG_3 | LWJSON_U8_TOO_LARGE,
+        LWJSON_U8_TOO_LONG | LWJSON_U8_OVERLONG_2 | LWJSON_U8_TWO_CONTS | LWJSON_U8_SURROGATE | LWJSON_U8_TOO_LARGE,
+        LWJSON_U8_TOO_LONG | LWJSON_U8_OVERLONG_2 | LWJSON_U8_TWO_CONTS | LWJSON_U8_SURROGATE | LWJSON_U8_TOO_LARGE,
+        LWJSON_U8_TOO_SHORT,
+        LWJSON_U8_TOO_SHORT,
+        LWJSON_U8_TOO_SHORT,
+        LWJSON_U8_TOO_SHORT,
+    },
+};
+
+/**
+ * \brief           Get UTF-8 errors of `32` bytes, with lookup tables indexed by nibbles of consecutive bytes
+ * \param[in]       in: Input bytes
+ * \param[in]       prev: Previous input bytes, zero at the beginning of string
+ * \param[in]       tbl: Lookup tables of \ref prv_u8_tbl, in both lanes
+ * \return          Non-zero bytes where sequence is not valid
+ */
+static inline __m256i
+prv_utf8_errors_avx2(__m256i in, __m256i prev, const __m256i* tbl) {
+    const __m256i nib = _mm256_set1_epi8(0x0F);
+    __m256i carry = _mm256_permute2x128_si256(prev, in, 0x21);
+    __m256i prev1 = _mm256_alignr_epi8(in, carry, 15);
+    __m256i prev2 = _mm256_alignr_epi8(in, carry, 14);
+    __m256i prev3 = _mm256_alignr_epi8(in, carry, 13);
+    __m256i err, must23;
+
+    /* Errors of 2-byte combinations */
+    err = _mm256_shuffle_epi8(tbl[0], _mm256_and_si256(_mm256_srli_epi16(prev1, 4), nib));
+    err = _mm256_and_si256(err, _mm256_shuffle_epi8(tbl[1], _mm256_and_si256(prev1, nib)));
+    err = _mm256_and_si256(err, _mm256_shuffle_epi8(tbl[2], _mm256_and_si256(_mm256_srli_epi16(in, 4), nib)));
+
+    /* Two continuation bytes are valid only as third and fourth byte of sequence */
+    must23 = _mm256_or_si256(_mm256_subs_epu8(prev2, _mm256_set1_epi8((char)0xDF)),
+                             _mm256_subs_epu8(prev3, _mm256_set1_epi8((char)0xEF)));
+    must23 = _mm256_and_si256(_mm256_cmpgt_epi8(must23, _mm256_setzero_si256()), _mm256_set1_epi8((char)0x80));
+    return _mm256_xor_si256(err, must23);
+}
+
+#endif /* LWJSON_USE_AVX2 */
+
+/**
+ * \brief           Check if string is well-formed UTF-8
+ * \param[in]       s: String to check
+ * \param[in]       len: Length of string
+ * \return          `1` if valid, `0` otherwise
+ */
+static uint8_t
+prv_utf8_check(const char* s, size_t len) {
+    size_t pos = prv_ascii_len(s, len);
+
+#if LWJSON_USE_AVX2
+    if (len - pos >= 32) {
+        __m256i tbl[3], prev, err;
+        size_t end;
+
+        for (size_t i = 0; i < 3; ++i) {
+            tbl[i] = _mm256_broadcastsi128_si256(_mm_loadu_si128((const __m128i*)(const void*)prv_u8_tbl[i]));
+        }
+
+        /* Bytes before the first non-ASCII are all ASCII, same as zero previous input */
+        prev = err = _mm256_setzero_si256();
+        for (; pos + 32 <= len; pos += 32) {
+            __m256i in = _mm256_loadu_si256((const __m256i*)(const void*)&s[pos]);
+            err = _mm256_or_si256(err, prv_utf8_errors_avx2(in, prev, tbl));
+            prev = in;
+        }
+        if (!_mm256_testz_si256(err, err)) {
+            return 0;
+        }
+
+        /* Sequence at the end of the last vector is checked again with the rest of string */
+        end = pos;
+        while (end + 3 > pos && ((uint8_t)s[end - 1] & 0xC0) == 0x80) {
+            --end;
+        }
+        if ((uint8_t)s[end - 1] >= 0xC0) {
+            pos = end - 1;
+        }
+    }
+#endif /* LWJSON_USE_AVX2 */
+    while (pos < len) {
+        uint8_t c = (uint8_t)s[pos++], lo = 0x80, hi = 0xBF, cont;
+
+        if (c < 0x80) {
+            continue;
+        } else if (c >= 0xC2 && c <= 0xDF) {
+            cont = 1;
+        } else if (c >= 0xE0 && c <= 0xEF) {
+            lo = c == 0xE0 ? 0xA0 : 0x80; /* Overlong form */
+            hi = c == 0xED ? 0x9F : 0xBF; /* Surrogates */
+            cont = 2;
+        } else if (c >= 0xF0 && c <= 0xF4) {
+            lo = c == 0xF0 ? 0x90 : 0x80; /* Overlong form */
+            hi = c == 0xF4 ? 0x8F : 0xBF; /* Above U+10FFFF */
+            cont = 3;
+        } else {
+            return 0;
+        }
+        if (cont > len - pos || (uint8_t)s[pos] < lo || (uint8_t)s[pos] > hi) {
+            return 0;
+        }
+        for (++pos; --cont > 0; ++pos) {
+            if (((uint8_t)s[pos] & 0xC0) != 0x80) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+#endif /* LWJSON_CFG_VALIDATE_UTF8 */
+
 /**
  * \brief           Parse JSON string that must start end end with double quotes `"` character
  * It just parses length of characters and does not perform any decode operation
  * \param[in,out]   pobj: Pointer to text that is modified on success
  * \param[out]      pout: Pointer to pointer to string that is set where string starts
  * \param[out]      poutlen: Length of string in units of characters is stored here
+ * \param[out]      pescaped: Set to `1` if string contains at least one escape sequence, `0` otherwise
  * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
  */
 static lwjsonr_t
-prv_parse_string(lwjson_int_str_t* pobj, const char** pout, size_t* poutlen) {
+prv_parse_string(lwjson_int_str_t* pobj, const char** pout, size_t* poutlen, uint8_t* pescaped) {
     lwjsonr_t res;
     size_t len = 0;
+    uint8_t escaped = 0;
 
     res = prv_skip_blank(pobj);
     if (res != lwjsonOK) {
@@ -116,16 +788,29 @@ prv_parse_string(lwjson_int_str_t* pobj, const char** pout, size_t* poutlen) {
         return lwjsonERRJSON;
     }
     *pout = pobj->p;
+#if LWJSON_CFG_VALIDATE_UTF8
+    pobj->high = 0;
+#endif /* LWJSON_CFG_VALIDATE_UTF8 */
     /* Parse string but take care of escape characters */
     for (;; ++pobj->p, ++len) {
-        if (pobj->p == NULL || *pobj->p == '\0' || (size_t)(pobj->p - pobj->start) >= pobj->len) {
+#if LWJSON_CFG_STRUCT_INDEX
+        /* Jump directly to the next character that needs attention */
+        len += prv_blk_skip_string_chars(pobj);
+#elif LWJSON_USE_AVX2 || LWJSON_USE_SSE2
+        len += prv_vec_skip_string_chars(pobj);
+#endif /* LWJSON_CFG_STRUCT_INDEX */
+        if (prv_str_is_end(pobj)) {
             return lwjsonERRJSON;
         }
+#if LWJSON_CFG_VALIDATE_UTF8
+        pobj->high |= (uint8_t)*pobj->p & 0x80;
+#endif /* LWJSON_CFG_VALIDATE_UTF8 */
         /* Check special characters */
         if (*pobj->p == '\\') {
             ++pobj->p;
             ++len;
-            switch (*pobj->p) {
+            escaped = 1;
+            switch (prv_str_peek(pobj, 0)) {
                 case '"':  /* fallthrough */
                 case '\\': /* fallthrough */
                 case '/':  /* fallthrough */
@@ -137,8 +822,9 @@ prv_parse_string(lwjson_int_str_t* pobj, const char** pout, size_t* poutlen) {
                 case 'u':
                     ++pobj->p;
                     for (size_t i = 0; i < 4; ++i, ++len) {
-                        if (!((*pobj->p >= '0' && *pobj->p <= '9') || (*pobj->p >= 'a' && *pobj->p <= 'f')
-                              || (*pobj->p >= 'A' && *pobj->p <= 'F'))) {
+                        char ch = prv_str_peek(pobj, 0);
+
+                        if (!((ch >= '0' && ch <= '9') || (ch >= 'a' && ch <= 'f') || (ch >= 'A' && ch <= 'F'))) {
                             return lwjsonERRJSON;
                         }
                         if (i < 3) {
@@ -153,7 +839,14 @@ prv_parse_string(lwjson_int_str_t* pobj, const char** pout, size_t* poutlen) {
             break;
         }
     }
+#if LWJSON_CFG_VALIDATE_UTF8
+    /* Only strings with non-ASCII bytes, found while scanning them, need full check */
+    if (pobj->high != 0 && !prv_utf8_check(*pout, len)) {
+        return lwjsonERRJSON;
+    }
+#endif /* LWJSON_CFG_VALIDATE_UTF8 */
     *poutlen = len;
+    *pescaped = escaped;
     return res;
 }
 
@@ -161,15 +854,17 @@ prv_parse_string(lwjson_int_str_t* pobj, const char** pout, size_t* poutlen) {
  * \brief           Parse property name that must comply with JSON string format as in RFC4627
  * Property string must be followed by colon character ":"
  * \param[in,out]   pobj: Pointer to text that is modified on success
- * \param[out]      t: Token instance to write property name to
+ * \param[out]      pname: Pointer to write beginning of property name to
+ * \param[out]      pname_len: Pointer to write length of property name to
+ * \param[out]      pescaped: Pointer to write escape sequence indication to
  * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
  */
 static lwjsonr_t
-prv_parse_property_name(lwjson_int_str_t* pobj, lwjson_token_t* t) {
+prv_parse_property_name(lwjson_int_str_t* pobj, const char** pname, size_t* pname_len, uint8_t* pescaped) {
     lwjsonr_t res;
 
     /* Parse property string first */
-    res = prv_parse_string(pobj, &t->token_name, &t->token_name_len);
+    res = prv_parse_string(pobj, pname, pname_len, pescaped);
     if (res != lwjsonOK) {
         return res;
     }
@@ -191,547 +886,4464 @@ prv_parse_property_name(lwjson_int_str_t* pobj, lwjson_token_t* t) {
 }
 
 /**
- * \brief           Parse number as described in RFC4627
+ * \brief           Parse literal value `true`, `false` or `null`
+ * \note            RFC4627 is lower-case only
  * \param[in,out]   pobj: Pointer to text that is modified on success
- * \param[out]      tout: Pointer to output number format
- * \param[out]      fout: Pointer to output real-type variable. Used if type is REAL.
- * \param[out]      iout: Pointer to output int-type variable. Used if type is INT.
+ * \param[out]      tout: Pointer to output literal type
  * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
  */
 static lwjsonr_t
-prv_parse_number(lwjson_int_str_t* pobj, lwjson_type_t* tout, lwjson_real_t* fout, lwjson_int_t* iout) {
+prv_parse_literal(lwjson_int_str_t* pobj, lwjson_type_t* tout) {
+    if (prv_str_has(pobj, 4) && strncmp(pobj->p, "true", 4) == 0) {
+        *tout = LWJSON_TYPE_TRUE;
+        pobj->p += 4;
+    } else if (prv_str_has(pobj, 5) && strncmp(pobj->p, "false", 5) == 0) {
+        *tout = LWJSON_TYPE_FALSE;
+        pobj->p += 5;
+    } else if (prv_str_has(pobj, 4) && strncmp(pobj->p, "null", 4) == 0) {
+        *tout = LWJSON_TYPE_NULL;
+        pobj->p += 4;
+    } else {
+        return lwjsonERRJSON;
+    }
+    return lwjsonOK;
+}
+
+/**
+ * \brief           Check characters after primitive value
+ *
+ * As per RFC4627, every token value may have one or more
+ * blank characters, followed by one of below options:
+ *  - Comma separator for next token
+ *  - End of array indication
+ *  - End of object indication
+ *
+ * \param[in,out]   pobj: Pointer to text that is modified on success
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+static lwjsonr_t
+prv_check_after_value(lwjson_int_str_t* pobj) {
     lwjsonr_t res;
-    uint8_t is_minus;
-    lwjson_real_t real_num = 0;
-    lwjson_int_t int_num = 0;
-    lwjson_type_t type = LWJSON_TYPE_NUM_INT;
 
     res = prv_skip_blank(pobj);
     if (res != lwjsonOK) {
         return res;
     }
-    if (*pobj->p == '\0' || (size_t)(pobj->p - pobj->start) >= pobj->len) {
-        return lwjsonERRJSON;
-    }
-    is_minus = *pobj->p == '-' ? (++pobj->p, 1) : 0;
-    if (*pobj->p == '\0'                    /* Invalid string */
-        || *pobj->p < '0' || *pobj->p > '9' /* Character outside number range */
-        || (*pobj->p == '0'
-            && (pobj->p[1] < '0' && pobj->p[1] > '9'))) { /* Number starts with 0 but not followed by dot */
+    /* Check if valid string is availabe after */
+    if (prv_str_is_end(pobj) || (*pobj->p != ',' && *pobj->p != ']' && *pobj->p != '}')) {
         return lwjsonERRJSON;
+    } else if (*pobj->p == ',') { /* Check to advance to next token immediatey */
+        ++pobj->p;
     }
+    return lwjsonOK;
+}
 
-    /* Parse number */
-    for (int_num = 0; *pobj->p >= '0' && *pobj->p <= '9'; ++pobj->p) {
-        int_num = int_num * (lwjson_int_t)10 + (*pobj->p - '0');
-    }
-
-    real_num = (lwjson_real_t)int_num;
+/* Maximal number of significant decimal digits kept in the 64-bit significand */
+#define LWJSON_DEC_MAX_DIGITS 19
 
-    if (pobj->p != NULL && *pobj->p == '.') { /* Number has exponent */
-        lwjson_real_t exp;
-        lwjson_int_t dec_num;
+/* Maximal length of number at the end of input, that is copied for conversion with C library */
+#define LWJSON_REAL_SLOW_MAX_LEN 63
 
-        real_num = (lwjson_real_t)int_num;
+/* Maximal positive value of \ref lwjson_int_t, limited to 64-bit range */
+#define LWJSON_INT_MAX_U64                                                                                             \
+    (UINT64_MAX >> (sizeof(lwjson_int_t) >= sizeof(uint64_t) ? 1 : (65 - 8 * sizeof(lwjson_int_t))))
 
-        type = LWJSON_TYPE_NUM_REAL;            /* Format is real */
-        ++pobj->p;                              /* Ignore comma character */
-        if (*pobj->p < '0' || *pobj->p > '9') { /* Must be followed by number characters */
-            return lwjsonERRJSON;
-        }
+/**
+ * \brief           Decimal number as collected from input text
+ */
+typedef struct {
+    uint64_t mant;     /*!< Significand with up to \ref LWJSON_DEC_MAX_DIGITS significant digits */
+    uint32_t digits;   /*!< Number of significant digits in significand */
+    int32_t exp10;     /*!< Decimal exponent to apply to significand */
+    uint8_t truncated; /*!< Set to `1` when non-zero digits did not fit to significand */
+    uint8_t is_minus;  /*!< Set to `1` for negative number */
+} lwjson_int_dec_t;
 
-        /* Get number after decimal point */
-        for (exp = (lwjson_real_t)1, dec_num = 0; *pobj->p >= '0' && *pobj->p <= '9';
-             ++pobj->p, exp *= (lwjson_real_t)10) {
-            dec_num = dec_num * (lwjson_int_t)10 + (lwjson_int_t)(*pobj->p - '0');
-        }
+/* Powers of ten. Exactly representable up to `1e22` for `double` and `1e10` for `float` type */
+static const lwjson_real_t prv_pow10[] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
 
-        /* Add decimal part to number */
-        real_num += (lwjson_real_t)dec_num / exp;
+/**
+ * \brief           Add next decimal digit to the number
+ * \param[in,out]   dec: Decimal number
+ * \param[in]       digit: Digit value, `0` to `9`
+ * \param[in]       is_fraction: Set to `1` if digit is part of fraction, `0` otherwise
+ */
+static inline void
+prv_dec_add_digit(lwjson_int_dec_t* dec, uint8_t digit, uint8_t is_fraction) {
+    if (dec->digits < LWJSON_DEC_MAX_DIGITS) {
+        dec->mant = dec->mant * 10 + digit;
+        dec->digits += dec->mant != 0 ? 1 : 0; /* Leading zeros are not significant */
+        dec->exp10 -= is_fraction;
+    } else {
+        dec->truncated |= digit != 0 ? 1 : 0;
+        dec->exp10 += !is_fraction;
     }
-    if (pobj->p != NULL && (*pobj->p == 'e' || *pobj->p == 'E')) { /* Engineering mode */
-        uint8_t is_minus_exp;
-        lwjson_int_t exp_cnt;
+}
 
-        type = LWJSON_TYPE_NUM_REAL;                         /* Format is real */
-        ++pobj->p;                                           /* Ignore enginnering sing part */
-        is_minus_exp = *pobj->p == '-' ? (++pobj->p, 1) : 0; /* Check if negative */
-        if (*pobj->p == '+') {                               /* Optional '+' is possible too */
-            ++pobj->p;
-        }
-        if (*pobj->p < '0' || *pobj->p > '9') { /* Must be followed by number characters */
-            return lwjsonERRJSON;
-        }
+/**
+ * \brief           Add `8` significant decimal digits to the number at once
+ * \note            Number must already have a non-zero significand
+ *                  and room for `8` more digits, \ref LWJSON_DEC_MAX_DIGITS
+ * \param[in,out]   dec: Decimal number
+ * \param[in]       val: Value of `8` digits, `0` to `99999999`
+ * \param[in]       is_fraction: Set to `1` if digits are part of fraction, `0` otherwise
+ */
+static inline void
+prv_dec_add_8digits(lwjson_int_dec_t* dec, uint32_t val, uint8_t is_fraction) {
+    dec->mant = dec->mant * 100000000 + val;
+    dec->digits += 8;
+    dec->exp10 -= is_fraction ? 8 : 0;
+}
 
-        /* Parse exponent number */
-        for (exp_cnt = 0; *pobj->p >= '0' && *pobj->p <= '9'; ++pobj->p) {
-            exp_cnt = exp_cnt * (lwjson_int_t)10 + (lwjson_int_t)(*pobj->p - '0');
-        }
+/**
+ * \brief           Parse `8` decimal digits at once (SWAR - SIMD within a register)
+ * \param[in]       pobj: JSON string
+ * \param[out]      val: Value of parsed digits
+ * \return          `1` if next `8` characters are all digits, `0` otherwise
+ */
+static inline uint8_t
+prv_parse_8digits(const lwjson_int_str_t* pobj, uint32_t* val) {
+    const uint8_t* p = (const uint8_t*)pobj->p;
+    uint64_t v;
 
-        /* Calculate new value for exponent 10^exponent */
-        /* TODO: We could change this to lookup tables... */
-        if (is_minus_exp) {
-            for (; exp_cnt > 0; real_num /= (lwjson_real_t)10, --exp_cnt) {}
-        } else {
-            for (; exp_cnt > 0; real_num *= (lwjson_real_t)10, --exp_cnt) {}
-        }
+    if (pobj->readable - (size_t)(pobj->p - pobj->start) < 8) {
+        return 0;
     }
 
-    /* Write output values */
-    if (tout != NULL) {
-        *tout = type;
-    }
-    if (type == LWJSON_TYPE_NUM_INT) {
-        *iout = is_minus ? -int_num : int_num;
-    } else {
-        *fout = is_minus ? -real_num : real_num;
+    /* Little-endian load, compilers merge it to single load on little-endian CPUs */
+    v = (uint64_t)p[0] | ((uint64_t)p[1] << 8) | ((uint64_t)p[2] << 16) | ((uint64_t)p[3] << 24)
+        | ((uint64_t)p[4] << 32) | ((uint64_t)p[5] << 40) | ((uint64_t)p[6] << 48) | ((uint64_t)p[7] << 56);
+
+    /* Every byte must be in range of `0x30` to `0x39` */
+    if (((v & 0xF0F0F0F0F0F0F0F0ULL) | (((v + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) >> 4))
+        != 0x3333333333333333ULL) {
+        return 0;
     }
-    return lwjsonOK;
+
+    /* Combine digits to pairs, pairs to quads and quads to final value */
+    v -= 0x3030303030303030ULL;
+    v = v * 10 + (v >> 8);
+    v = ((v & 0x000000FF000000FFULL) * (100 + (1000000ULL << 32))
+         + ((v >> 16) & 0x000000FF000000FFULL) * (1 + (10000ULL << 32)))
+        >> 32;
+    *val = (uint32_t)v;
+    return 1;
 }
 
 /**
- * \brief           Create path segment from input path for search operation
- * \param[in,out]   ppath: Pointer to pointer to input path. Pointer is modified
- * \param[out]      opath: Pointer to pointer to write path segment
- * \param[out]      olen: Pointer to variable to write length of segment
- * \param[out]      is_last: Pointer to write if this is last segment
- * \return          `1` on success, `0` otherwise
+ * \brief           Parse sequence of decimal digits to the number
+ * \param[in,out]   pobj: JSON string, pointer is moved after last digit
+ * \param[in,out]   dec: Decimal number
+ * \param[in]       is_fraction: Set to `1` if digits are part of fraction, `0` otherwise
+ */
+static void
+prv_parse_digits(lwjson_int_str_t* pobj, lwjson_int_dec_t* dec, uint8_t is_fraction) {
+    uint32_t val;
+    char ch;
+
+    while ((ch = prv_str_peek(pobj, 0)) >= '0' && ch <= '9') {
+        /* Take 8 digits at once while they all fit to significand */
+        if (dec->mant != 0 && dec->digits <= LWJSON_DEC_MAX_DIGITS - 8 && prv_parse_8digits(pobj, &val)) {
+            prv_dec_add_8digits(dec, val, is_fraction);
+            pobj->p += 8;
+        } else {
+            prv_dec_add_digit(dec, (uint8_t)(ch - '0'), is_fraction);
+            ++pobj->p;
+        }
+    }
+}
+
+/**
+ * \brief           Scale real number with power of ten
+ * \param[in]       val: Value to scale
+ * \param[in]       exp10: Decimal exponent
+ * \return          Scaled value
+ */
+static lwjson_real_t
+prv_real_scale(lwjson_real_t val, int32_t exp10) {
+    const int32_t max = (int32_t)LWJSON_ARRAYSIZE(prv_pow10) - 1;
+
+    /* Loops end early once value reaches zero or infinity */
+    if (exp10 < 0) {
+        for (; exp10 < -max && val != 0; exp10 += max) {
+            val /= prv_pow10[max];
+        }
+        val /= prv_pow10[exp10 < -max ? max : -exp10];
+    } else {
+        for (; exp10 > max && val - val == 0; exp10 -= max) {
+            val *= prv_pow10[max];
+        }
+        val *= prv_pow10[exp10 > max ? max : exp10];
+    }
+    return val;
+}
+
+#if LWJSON_CFG_REAL_EXACT
+
+/**
+ * \brief           Binary floating point format description
+ */
+typedef struct {
+    uint32_t mant_bits; /*!< Number of explicitly stored mantissa bits */
+    int32_t bias;       /*!< Exponent bias */
+    uint64_t exp_inf;   /*!< Biased exponent of infinity */
+    int32_t exp10_min;  /*!< Any decimal exponent below gives zero, for 19-digit significand */
+    int32_t exp10_max;  /*!< Any decimal exponent above gives infinity */
+} lwjson_int_fp_fmt_t;
+
+static const lwjson_int_fp_fmt_t prv_fmt_binary32 = {23, 127, 0xFF, -65, 38};
+static const lwjson_int_fp_fmt_t prv_fmt_binary64 = {52, 1023, 0x7FF, -342, 308};
+
+/**
+ * \brief           Get number of leading zero bits
+ * \param[in]       x: Value to check. Must not be `0`
+ * \return          Number of zero bits above the most significant set bit
+ */
+static inline uint32_t
+prv_clz64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint32_t)__builtin_clzll(x);
+#else
+    uint32_t n = 0;
+    for (; (x & ((uint64_t)1 << 63)) == 0; x <<= 1, ++n) {}
+    return n;
+#endif
+}
+
+/**
+ * \brief           Multiply two 64-bit values to 128-bit result
+ * \param[in]       a: First value
+ * \param[in]       b: Second value
+ * \param[out]      hi: High 64 bits of the result
+ * \param[out]      lo: Low 64 bits of the result
+ */
+static inline void
+prv_mul_64x64(uint64_t a, uint64_t b, uint64_t* hi, uint64_t* lo) {
+#if defined(__SIZEOF_INT128__)
+    __extension__ typedef unsigned __int128 u128_t;
+    u128_t r = (u128_t)a * b;
+
+    *hi = (uint64_t)(r >> 64);
+    *lo = (uint64_t)r;
+#else
+    uint64_t a_lo = (uint32_t)a, a_hi = a >> 32, b_lo = (uint32_t)b, b_hi = b >> 32;
+    uint64_t p0 = a_lo * b_lo, p1 = a_lo * b_hi, p2 = a_hi * b_lo, p3 = a_hi * b_hi;
+    uint64_t mid = (p0 >> 32) + (uint32_t)p1 + (uint32_t)p2;
+
+    *hi = p3 + (p1 >> 32) + (p2 >> 32) + (mid >> 32);
+    *lo = (mid << 32) | (uint32_t)p0;
+#endif
+}
+
+/**
+ * \brief           Convert decimal to binary floating point with Eisel-Lemire algorithm
+ * \param[in]       fmt: Output floating point format
+ * \param[in]       mant: Decimal significand. Must not be `0`
+ * \param[in]       exp10: Decimal exponent, in range of the output format
+ * \param[out]      bits: Output raw bits, without sign bit
+ * \return          `1` on success, `0` if result cannot be decided and slow path shall be used
  */
 static uint8_t
-prv_create_path_segment(const char** ppath, const char** opath, size_t* olen, uint8_t* is_last) {
-    const char* segment = *ppath;
+prv_eisel_lemire(const lwjson_int_fp_fmt_t* fmt, uint64_t mant, int32_t exp10, uint64_t* bits) {
+    const uint64_t* pow10 = prv_pow10_tbl[exp10 - LWJSON_POW10_TBL_MIN_EXP10];
+    const uint64_t mask = ((uint64_t)1 << (64 - fmt->mant_bits - 3)) - 1;
+    uint64_t x_hi, x_lo, ret_mant, ret_exp2, msb;
+    int32_t exp2;
+    uint32_t clz;
 
-    *is_last = 0;
-    *opath = NULL;
-    *olen = 0;
+    /* Normalize significand, binary exponent of power of ten is floor(exp10 * log2(10)) */
+    clz = prv_clz64(mant);
+    mant <<= clz;
+    exp2 = 217706 * exp10;
+    exp2 = exp2 >= 0 ? (exp2 >> 16) : -((-exp2 + 0xFFFF) >> 16);
+    ret_exp2 = (uint64_t)(int64_t)(exp2 + 64 + fmt->bias) - clz;
 
-    /* Check input path */
-    if (segment == NULL || *segment == '\0') {
-        *is_last = 1;
+    /* Multiply with high part first, use low part only when result is too close to rounding boundary */
+    prv_mul_64x64(mant, pow10[0], &x_hi, &x_lo);
+    if ((x_hi & mask) == mask && x_lo + mant < mant) {
+        uint64_t y_hi, y_lo, merged_hi, merged_lo;
+
+        prv_mul_64x64(mant, pow10[1], &y_hi, &y_lo);
+        merged_hi = x_hi;
+        merged_lo = x_lo + y_hi;
+        if (merged_lo < x_lo) {
+            ++merged_hi;
+        }
+        if ((merged_hi & mask) == mask && merged_lo + 1 == 0 && y_lo + mant < mant) {
+            return 0;
+        }
+        x_hi = merged_hi;
+        x_lo = merged_lo;
+    }
+
+    /* Shift to mantissa bits plus one rounding bit */
+    msb = x_hi >> 63;
+    ret_mant = x_hi >> (msb + 64 - fmt->mant_bits - 3);
+    ret_exp2 -= 1 ^ msb;
+
+    /* Exactly half-way between two values cannot be decided here */
+    if (x_lo == 0 && (x_hi & mask) == 0 && (ret_mant & 0x03) == 1) {
         return 0;
     }
 
-    /*
-     * Path must be one of:
-     * - literal text
-     * - "#" followed by dot "."
-     */
-    if (*segment == '#') {
-        *opath = segment;
-        for (*olen = 0;; ++segment, ++(*olen)) {
-            if (*segment == '.') {
-                ++segment;
-                break;
-            } else if (*segment == '\0') {
-                if (*olen == 1) {
-                    return 0;
-                } else {
-                    break;
-                }
-            }
-        }
-        *ppath = segment;
-    } else {
-        *opath = segment;
-        for (*olen = 0; *segment != '\0' && *segment != '.'; ++(*olen), ++segment) {}
-        *ppath = segment + 1;
+    /* Round to nearest */
+    ret_mant += ret_mant & 0x01;
+    ret_mant >>= 1;
+    if ((ret_mant >> (fmt->mant_bits + 1)) > 0) {
+        ret_mant >>= 1;
+        ++ret_exp2;
     }
-    if (*segment == '\0') {
-        *is_last = 1;
+
+    /* Subnormal numbers and overflow are left to slow path */
+    if (ret_exp2 - 1 >= fmt->exp_inf - 1) {
+        return 0;
     }
+    *bits = (ret_exp2 << fmt->mant_bits) | (ret_mant & (((uint64_t)1 << fmt->mant_bits) - 1));
     return 1;
 }
 
 /**
- * \brief           Input recursive function for find operation
- * \param[in]       parent: Parent token of type \ref LWJSON_TYPE_ARRAY or LWJSON_TYPE_OBJECT
- * \param[in]       path: Path to search for starting this token further
- * \return          Found token on success, `NULL` otherwise
+ * \brief           Create real number from raw bits of its binary format
+ * \param[in]       bits: Raw bits, without sign bit
+ * \param[in]       is_minus: Set to `1` for negative number
+ * \return          Real number
  */
-static const lwjson_token_t*
-prv_find(const lwjson_token_t* parent, const char* path) {
-    const char* segment;
-    size_t segment_len;
-    uint8_t is_last, res;
+static lwjson_real_t
+prv_real_from_bits(uint64_t bits, uint8_t is_minus) {
+    if (sizeof(lwjson_real_t) == sizeof(float)) {
+        uint32_t b32 = (uint32_t)bits | (is_minus ? (uint32_t)1 << 31 : 0);
+        float f;
 
-    /* Get path segments */
-    res = prv_create_path_segment(&path, &segment, &segment_len, &is_last);
-    if (res != 0) {
-        /* Check if detected an array request */
-        if (*segment == '#') {
-            /* Parent must be array */
-            if (parent->type != LWJSON_TYPE_ARRAY) {
-                return NULL;
-            }
+        LWJSON_MEMCPY(&f, &b32, sizeof(f));
+        return (lwjson_real_t)f;
+    } else {
+        uint64_t b64 = bits | (is_minus ? (uint64_t)1 << 63 : 0);
+        double d;
 
-            /* Check if index requested */
-            if (segment_len > 1) {
-                const lwjson_token_t* tkn;
-                size_t index = 0;
+        LWJSON_MEMCPY(&d, &b64, sizeof(d));
+        return (lwjson_real_t)d;
+    }
+}
+#endif /* LWJSON_CFG_REAL_EXACT */
 
-                /* Parse number */
-                for (size_t i = 1; i < segment_len; ++i) {
-                    if (segment[i] < '0' || segment[i] > '9') {
-                        return NULL;
-                    } else {
-                        index = index * 10 + (segment[i] - '0');
-                    }
-                }
+/**
+ * \brief           Convert decimal number to real number
+ * \param[in]       dec: Decimal number
+ * \param[in]       start: Pointer to first character of the number in the input text
+ * \param[in]       pobj: JSON string, with current pointer at first character after the number
+ * \return          Real number
+ */
+static lwjson_real_t
+prv_dec_to_real(const lwjson_int_dec_t* dec, const char* start, const lwjson_int_str_t* pobj) {
+    lwjson_real_t real_num;
 
-                /* Start from beginning */
-                for (tkn = parent->u.first_child; tkn != NULL && index > 0; tkn = tkn->next, --index) {}
-                if (tkn != NULL) {
-                    if (is_last) {
-                        return tkn;
-                    } else {
-                        return prv_find(tkn, path);
-                    }
-                }
-                return NULL;
-            }
+#if LWJSON_CFG_REAL_EXACT
+    if (sizeof(lwjson_real_t) == sizeof(float) || sizeof(lwjson_real_t) == sizeof(double)) {
+        const uint8_t is_f32 = sizeof(lwjson_real_t) == sizeof(float);
+        const lwjson_int_fp_fmt_t* fmt = is_f32 ? &prv_fmt_binary32 : &prv_fmt_binary64;
+        uint64_t bits, bits_up;
 
-            /* Scan all indexes and get first match */
-            for (const lwjson_token_t* tkn = parent->u.first_child; tkn != NULL; tkn = tkn->next) {
-                const lwjson_token_t* tmp = prv_find(tkn, path);
-                if (tmp != NULL) {
-                    return tmp;
+        if (dec->mant == 0 || dec->exp10 < fmt->exp10_min) {
+            return prv_real_from_bits(0, dec->is_minus);
+        } else if (dec->exp10 > fmt->exp10_max) {
+            return prv_real_from_bits(fmt->exp_inf << fmt->mant_bits, dec->is_minus);
+        }
+
+        /* Both significand and power of ten are exact, single operation rounds correctly */
+        if (!dec->truncated && dec->mant <= ((uint64_t)1 << (fmt->mant_bits + 1))
+            && dec->exp10 >= -(is_f32 ? 10 : 22) && dec->exp10 <= (is_f32 ? 10 : 22)) {
+            real_num = (lwjson_real_t)dec->mant;
+            real_num = dec->exp10 < 0 ? real_num / prv_pow10[-dec->exp10] : real_num * prv_pow10[dec->exp10];
+            return dec->is_minus ? -real_num : real_num;
+        }
+
+        /* Dropped digits are handled by checking that next significand rounds to the same value */
+        if (prv_eisel_lemire(fmt, dec->mant, dec->exp10, &bits)
+            && (!dec->truncated || (prv_eisel_lemire(fmt, dec->mant + 1, dec->exp10, &bits_up) && bits == bits_up))) {
+            return prv_real_from_bits(bits, dec->is_minus);
+        }
+
+        /* Slow path, accepted only if C library agrees on number length (decimal point of locale) */
+        {
+            char buff[LWJSON_REAL_SLOW_MAX_LEN + 1];
+            size_t len = (size_t)(pobj->p - start);
+            const char* str = start;
+            char* conv_end;
+
+            /* C library reads up to the first character after the number, that may be beyond the end of input */
+            if ((size_t)(pobj->p - pobj->start) >= pobj->readable) {
+                if (len > LWJSON_REAL_SLOW_MAX_LEN) {
+                    str = NULL;
+                } else {
+                    LWJSON_MEMCPY(buff, start, len);
+                    buff[len] = '\0';
+                    str = buff;
                 }
             }
-        } else {
-            if (parent->type != LWJSON_TYPE_OBJECT) {
-                return NULL;
-            }
-            for (const lwjson_token_t* tkn = parent->u.first_child; tkn != NULL; tkn = tkn->next) {
-                if (tkn->token_name_len == segment_len && !strncmp(tkn->token_name, segment, segment_len)) {
-                    const lwjson_token_t* tmp;
-                    if (is_last) {
-                        return tkn;
-                    }
-                    tmp = prv_find(tkn, path);
-                    if (tmp != NULL) {
-                        return tmp;
-                    }
+            if (str != NULL) {
+                real_num = is_f32 ? (lwjson_real_t)strtof(str, &conv_end) : (lwjson_real_t)strtod(str, &conv_end);
+                if (conv_end == str + len) {
+                    return real_num;
                 }
             }
         }
     }
-    return NULL;
+#else
+    (void)start;
+    (void)pobj;
+#endif /* LWJSON_CFG_REAL_EXACT */
+
+    real_num = prv_real_scale((lwjson_real_t)dec->mant, dec->exp10);
+    return dec->is_minus ? -real_num : real_num;
+}
+
+/**
+ * \brief           Parse number as described in RFC4627
+ * \param[in,out]   pobj: Pointer to text that is modified on success
+ * \param[out]      tout: Pointer to output number format
+ * \param[out]      fout: Pointer to output real-type variable. Used if type is REAL.
+ * \param[out]      iout: Pointer to output int-type variable. Used if type is INT.
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+static lwjsonr_t
+prv_parse_number(lwjson_int_str_t* pobj, lwjson_type_t* tout, lwjson_real_t* fout, lwjson_int_t* iout) {
+    lwjsonr_t res;
+    const char* start;
+    lwjson_int_dec_t dec = {0};
+    lwjson_type_t type = LWJSON_TYPE_NUM_INT;
+    char ch;
+
+    res = prv_skip_blank(pobj);
+    if (res != lwjsonOK) {
+        return res;
+    }
+    if (prv_str_is_end(pobj)) {
+        return lwjsonERRJSON;
+    }
+    start = pobj->p;
+    dec.is_minus = *pobj->p == '-' ? (++pobj->p, 1) : 0;
+    ch = prv_str_peek(pobj, 0);
+    if (ch == '\0'              /* Invalid string */
+        || ch < '0' || ch > '9' /* Character outside number range */
+        || (ch == '0'
+            && (prv_str_peek(pobj, 1) < '0'
+                && prv_str_peek(pobj, 1) > '9'))) { /* Number starts with 0 but not followed by dot */
+        return lwjsonERRJSON;
+    }
+
+    /* Parse number */
+    prv_parse_digits(pobj, &dec, 0);
+
+    if (prv_str_peek(pobj, 0) == '.') { /* Number has exponent */
+        type = LWJSON_TYPE_NUM_REAL;    /* Format is real */
+        ++pobj->p;                      /* Ignore comma character */
+        ch = prv_str_peek(pobj, 0);
+        if (ch < '0' || ch > '9') { /* Must be followed by number characters */
+            return lwjsonERRJSON;
+        }
+
+        /* Get number after decimal point */
+        prv_parse_digits(pobj, &dec, 1);
+    }
+    ch = prv_str_peek(pobj, 0);
+    if (ch == 'e' || ch == 'E') { /* Engineering mode */
+        uint8_t is_minus_exp;
+        int32_t exp_cnt;
+
+        type = LWJSON_TYPE_NUM_REAL; /* Format is real */
+        ++pobj->p;                   /* Ignore enginnering sing part */
+        is_minus_exp = prv_str_peek(pobj, 0) == '-' ? (++pobj->p, 1) : 0; /* Check if negative */
+        if (prv_str_peek(pobj, 0) == '+') {                                /* Optional '+' is possible too */
+            ++pobj->p;
+        }
+        ch = prv_str_peek(pobj, 0);
+        if (ch < '0' || ch > '9') { /* Must be followed by number characters */
+            return lwjsonERRJSON;
+        }
+
+        /* Parse exponent number, larger exponents give zero or infinity anyway */
+        for (exp_cnt = 0; (ch = prv_str_peek(pobj, 0)) >= '0' && ch <= '9'; ++pobj->p) {
+            if (exp_cnt < 100000) {
+                exp_cnt = exp_cnt * 10 + (int32_t)(ch - '0');
+            }
+        }
+        dec.exp10 += is_minus_exp ? -exp_cnt : exp_cnt;
+    }
+
+    /* Write output values */
+    if (tout != NULL) {
+        *tout = type;
+    }
+    if (type == LWJSON_TYPE_NUM_INT) {
+        /* Dropped digits (positive exponent) or significand above limit, negative range is one larger */
+        if (dec.exp10 != 0 || dec.mant > LWJSON_INT_MAX_U64 + dec.is_minus) {
+            return lwjsonERRNUMRANGE;
+        }
+        if (dec.is_minus && dec.mant > 0) {
+            *iout = -(lwjson_int_t)(dec.mant - 1) - 1;
+        } else {
+            *iout = (lwjson_int_t)dec.mant;
+        }
+    } else {
+        *fout = prv_dec_to_real(&dec, start, pobj);
+    }
+    return lwjsonOK;
+}
+
+#if LWJSON_CFG_LAZY_NUMBER || LWJSON_CFG_ON_DEMAND
+
+/* Integer numbers with up to this number of digits always fit to \ref lwjson_int_t */
+#define LWJSON_INT_SAFE_DIGITS (sizeof(lwjson_int_t) >= 8 ? 18 : (sizeof(lwjson_int_t) >= 4 ? 9 : 4))
+
+/**
+ * \brief           Validate number as described in RFC4627, without converting it
+ *
+ * Integer numbers too long to be surely in range of \ref lwjson_int_t are converted,
+ * to report \ref lwjsonERRNUMRANGE at parse time, the same way as without lazy conversion.
+ *
+ * \param[in,out]   pobj: Pointer to text that is modified on success
+ * \param[out]      tout: Pointer to output number format
+ * \param[out]      pstart: Pointer to first character of the number
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+static lwjsonr_t
+prv_scan_number(lwjson_int_str_t* pobj, lwjson_type_t* tout, const char** pstart) {
+    lwjsonr_t res;
+    const char* digits;
+    lwjson_type_t type = LWJSON_TYPE_NUM_INT;
+    char ch;
+
+    res = prv_skip_blank(pobj);
+    if (res != lwjsonOK) {
+        return res;
+    }
+    if (prv_str_is_end(pobj)) {
+        return lwjsonERRJSON;
+    }
+    *pstart = pobj->p;
+    if (*pobj->p == '-') {
+        ++pobj->p;
+    }
+    ch = prv_str_peek(pobj, 0);
+    if (ch < '0' || ch > '9') {
+        return lwjsonERRJSON;
+    }
+    for (digits = pobj->p; (ch = prv_str_peek(pobj, 0)) >= '0' && ch <= '9'; ++pobj->p) {}
+    if ((size_t)(pobj->p - digits) > LWJSON_INT_SAFE_DIGITS) {
+        digits = NULL; /* Range is checked once number is known to be integer */
+    }
+
+    if (ch == '.') {
+        type = LWJSON_TYPE_NUM_REAL;
+        ++pobj->p;
+        ch = prv_str_peek(pobj, 0);
+        if (ch < '0' || ch > '9') {
+            return lwjsonERRJSON;
+        }
+        for (; (ch = prv_str_peek(pobj, 0)) >= '0' && ch <= '9'; ++pobj->p) {}
+    }
+    if (ch == 'e' || ch == 'E') {
+        type = LWJSON_TYPE_NUM_REAL;
+        ++pobj->p;
+        ch = prv_str_peek(pobj, 0);
+        if (ch == '-' || ch == '+') {
+            ++pobj->p;
+            ch = prv_str_peek(pobj, 0);
+        }
+        if (ch < '0' || ch > '9') {
+            return lwjsonERRJSON;
+        }
+        for (; (ch = prv_str_peek(pobj, 0)) >= '0' && ch <= '9'; ++pobj->p) {}
+    }
+
+    /* Long integer, convert it to check the range */
+    if (type == LWJSON_TYPE_NUM_INT && digits == NULL) {
+        lwjson_int_str_t num = *pobj;
+        lwjson_int_t int_num;
+
+        num.p = *pstart;
+        res = prv_parse_number(&num, NULL, NULL, &int_num);
+        if (res != lwjsonOK) {
+            return res;
+        }
+    }
+    *tout = type;
+    return lwjsonOK;
+}
+
+#endif /* LWJSON_CFG_LAZY_NUMBER || LWJSON_CFG_ON_DEMAND */
+
+#if LWJSON_CFG_LAZY_NUMBER
+
+/**
+ * \brief           Convert number token, parsed with lazy conversion
+ * \param[in]       token: Token with number type
+ * \param[out]      fout: Pointer to output real-type variable. Used if type is REAL.
+ * \param[out]      iout: Pointer to output int-type variable. Used if type is INT.
+ */
+static void
+prv_convert_number(const lwjson_token_t* token, lwjson_real_t* fout, lwjson_int_t* iout) {
+    lwjson_int_str_t pobj = {
+        .start = token->u.str.token_value,
+        .len = token->u.str.token_value_len,
+        .p = token->u.str.token_value,
+    };
+
+    prv_str_init(&pobj);
+    if (prv_parse_number(&pobj, NULL, fout, iout) != lwjsonOK) {
+        *fout = 0;
+        *iout = 0;
+    }
+}
+
+/**
+ * \brief           Get token value for \ref LWJSON_TYPE_NUM_INT type
+ * \note            Number is converted from input text on every call
+ * \param[in]       token: token with integer type
+ * \return          Int number if type is integer, `0` otherwise
+ */
+lwjson_int_t
+lwjson_get_val_int(const lwjson_token_t* token) {
+    lwjson_real_t real_num = 0;
+    lwjson_int_t int_num = 0;
+
+    if (token != NULL && token->type == LWJSON_TYPE_NUM_INT) {
+        prv_convert_number(token, &real_num, &int_num);
+    }
+    return int_num;
+}
+
+/**
+ * \brief           Get token value for \ref LWJSON_TYPE_NUM_REAL type
+ * \note            Number is converted from input text on every call
+ * \param[in]       token: token with real type
+ * \return          Real number if type is real, `0` otherwise
+ */
+lwjson_real_t
+lwjson_get_val_real(const lwjson_token_t* token) {
+    lwjson_real_t real_num = 0;
+    lwjson_int_t int_num = 0;
+
+    if (token != NULL && token->type == LWJSON_TYPE_NUM_REAL) {
+        prv_convert_number(token, &real_num, &int_num);
+    }
+    return real_num;
+}
+
+#endif /* LWJSON_CFG_LAZY_NUMBER */
+
+/**
+ * \brief           Get value of hexadecimal digit
+ * \param[in]       ch: Hexadecimal digit character, already validated by the parser
+ * \return          Value of the digit
+ */
+static inline uint32_t
+prv_hex_digit(char ch) {
+    if (ch >= '0' && ch <= '9') {
+        return (uint32_t)(ch - '0');
+    }
+    return (uint32_t)((ch | 0x20) - 'a' + 10);
+}
+
+/**
+ * \brief           Get code unit of `\uXXXX` escape sequence
+ * \param[in]       s: Pointer to first of `4` hexadecimal digits
+ * \return          Code unit
+ */
+static uint32_t
+prv_hex4(const char* s) {
+    return (prv_hex_digit(s[0]) << 12) | (prv_hex_digit(s[1]) << 8) | (prv_hex_digit(s[2]) << 4) | prv_hex_digit(s[3]);
+}
+
+/**
+ * \brief           Decode escape sequence of string to UTF-8
+ *
+ * Surrogate pair of two `\uXXXX` sequences is decoded to single code point.
+ * Unpaired surrogate is decoded to replacement character `U+FFFD`.
+ *
+ * \param[in]       s: Pointer to backslash character of escape sequence
+ * \param[in]       len: Number of characters from backslash to the end of string
+ * \param[out]      out: Buffer of at least `4` bytes for decoded characters
+ * \param[out]      out_len: Number of decoded bytes
+ * \return          Number of characters of the escape sequence
+ */
+static size_t
+prv_decode_escape(const char* s, size_t len, char* out, size_t* out_len) {
+    uint32_t cp;
+    size_t used = 6;
+
+    *out_len = 1;
+    switch (s[1]) {
+        case 'b': out[0] = '\b'; return 2;
+        case 'f': out[0] = '\f'; return 2;
+        case 'n': out[0] = '\n'; return 2;
+        case 'r': out[0] = '\r'; return 2;
+        case 't': out[0] = '\t'; return 2;
+        case 'u': break;
+        default: out[0] = s[1]; return 2;
+    }
+    cp = prv_hex4(&s[2]);
+    if (cp >= 0xD800 && cp <= 0xDBFF && len >= 12 && s[6] == '\\' && s[7] == 'u') {
+        uint32_t lo = prv_hex4(&s[8]);
+
+        if (lo >= 0xDC00 && lo <= 0xDFFF) {
+            cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+            used = 12;
+        }
+    }
+    if (cp >= 0xD800 && cp <= 0xDFFF) {
+        cp = 0xFFFD;
+    }
+
+    /* Encode code point to UTF-8 */
+    if (cp < 0x80) {
+        out[0] = (char)cp;
+    } else if (cp < 0x800) {
+        out[0] = (char)(0xC0 | (cp >> 6));
+        out[1] = (char)(0x80 | (cp & 0x3F));
+        *out_len = 2;
+    } else if (cp < 0x10000) {
+        out[0] = (char)(0xE0 | (cp >> 12));
+        out[1] = (char)(0x80 | ((cp >> 6) & 0x3F));
+        out[2] = (char)(0x80 | (cp & 0x3F));
+        *out_len = 3;
+    } else {
+        out[0] = (char)(0xF0 | (cp >> 18));
+        out[1] = (char)(0x80 | ((cp >> 12) & 0x3F));
+        out[2] = (char)(0x80 | ((cp >> 6) & 0x3F));
+        out[3] = (char)(0x80 | (cp & 0x3F));
+        *out_len = 4;
+    }
+    return used;
+}
+
+/**
+ * \brief           Get number of characters until next escape sequence
+ * \param[in]       s: String to check
+ * \param[in]       len: Length of string
+ * \return          Position of next backslash character, or `len` if there is none
+ */
+static inline size_t
+prv_find_escape(const char* s, size_t len) {
+    const char* bs;
+    size_t pos = 0;
+
+#if LWJSON_USE_AVX2
+    for (; pos + 32 <= len; pos += 32) {
+        __m256i v = _mm256_loadu_si256((const __m256i*)(const void*)&s[pos]);
+        uint32_t mask = (uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_set1_epi8('\\')));
+        if (mask != 0) {
+            return pos + prv_ctz64(mask);
+        }
+    }
+#elif LWJSON_USE_SSE2
+    for (; pos + 16 <= len; pos += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i*)(const void*)&s[pos]);
+        uint32_t mask = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8('\\')));
+        if (mask != 0) {
+            return pos + prv_ctz64(mask);
+        }
+    }
+#endif /* LWJSON_USE_AVX2 */
+    bs = memchr(&s[pos], '\\', len - pos);
+    return bs != NULL ? (size_t)(bs - s) : len;
+}
+
+/**
+ * \brief           Decode escape sequences of string to UTF-8
+ *
+ * Runs of characters between escape sequences are copied at once.
+ * Decoded string is never longer than the original, buffer may start at the same position as the string.
+ *
+ * \param[in]       src: String to decode
+ * \param[in]       len: Length of string
+ * \param[out]      buf: Buffer for decoded string
+ * \param[in]       buf_len: Size of buffer in units of bytes
+ * \return          Length of decoded string, `SIZE_MAX` if buffer is too small
+ */
+static size_t
+prv_decode_string(const char* src, size_t len, char* buf, size_t buf_len) {
+    size_t s = 0, d = 0;
+
+    while (s < len) {
+        size_t n = prv_find_escape(&src[s], len - s), esc_len;
+        char esc[4];
+
+        if (n > buf_len - d) {
+            return SIZE_MAX;
+        }
+        memmove(&buf[d], &src[s], n);
+        s += n;
+        d += n;
+        if (s == len) {
+            break;
+        }
+        s += prv_decode_escape(&src[s], len - s, esc, &esc_len);
+        if (esc_len > buf_len - d) {
+            return SIZE_MAX;
+        }
+        LWJSON_MEMCPY(&buf[d], esc, esc_len);
+        d += esc_len;
+    }
+    return d;
+}
+
+#if LWJSON_CFG_INSITU
+
+/**
+ * \brief           Decode string of writable input data in place and terminate it with `NULL` character
+ * \param[in]       str: String in input data, followed by closing double quote
+ * \param[in,out]   len: Length of string, set to length of decoded string on return
+ * \param[in,out]   escaped: Escape sequence indication, cleared on return
+ */
+static void
+prv_insitu_string(const char* str, size_t* len, uint8_t* escaped) {
+    char* s = (char*)str; /* Input data of in-situ parsing is writable */
+
+    if (*escaped) {
+        *len = prv_decode_string(s, *len, s, *len);
+        *escaped = 0;
+    }
+    s[*len] = '\0';
+}
+
+#endif /* LWJSON_CFG_INSITU */
+
+/**
+ * \brief           Get string value of the token, with escape sequences decoded to UTF-8
+ *
+ * When value has no escape sequences, pointer to the original data is returned and nothing is copied.
+ * Otherwise value is decoded to the buffer, with runs of characters between escape sequences copied at once.
+ * Surrogate pairs are decoded to single code point, unpaired surrogates to replacement character `U+FFFD`.
+ *
+ * \note            Returned string is not `NULL`-terminated, decoded value may contain `\0` characters
+ * \param[in]       lwobj: LwJSON instance used to parse the token
+ * \param[in]       token: Token with string type
+ * \param[out]      buf: Buffer for decoded string. Decoded string is never longer than the original
+ * \param[in]       buf_len: Size of buffer in units of bytes
+ * \param[out]      str_len: Pointer to variable holding length of decoded string.
+ *                      Set to `NULL` if not used
+ * \return          Pointer to decoded string, `NULL` if token is not string or buffer is too small
+ */
+const char*
+lwjson_get_val_string_decoded(const lwjson_t* lwobj, const lwjson_token_t* token, char* buf, size_t buf_len,
+                              size_t* str_len) {
+    const char* src;
+    size_t len;
+
+    if ((src = lwjson_get_val_string_ex(lwobj, token, &len)) == NULL) {
+        return NULL;
+    }
+    if (!token->flags.value_escaped) {
+        if (str_len != NULL) {
+            *str_len = len;
+        }
+        return src;
+    }
+    if (buf == NULL || (len = prv_decode_string(src, len, buf, buf_len)) == SIZE_MAX) {
+        return NULL;
+    }
+    if (str_len != NULL) {
+        *str_len = len;
+    }
+    return buf;
+}
+
+/**
+ * \brief           Compare decoded string value of the token with user input string for a case-sensitive match
+ *
+ * Escape sequences are decoded while comparing, no buffer is needed.
+ * Unlike \ref lwjson_string_compare_ex, full string must match.
+ *
+ * \param[in]       lwobj: LwJSON instance used to parse the token
+ * \param[in]       token: Token with string type
+ * \param[in]       str: String to compare, encoded as UTF-8
+ * \param[in]       len: Length of the string in bytes
+ * \return          `1` if equal, `0` otherwise
+ */
+uint8_t
+lwjson_string_compare_decoded(const lwjson_t* lwobj, const lwjson_token_t* token, const char* str, size_t len) {
+    const char* src;
+    size_t src_len, s = 0, d = 0;
+
+    if (str == NULL || (src = lwjson_get_val_string_ex(lwobj, token, &src_len)) == NULL) {
+        return 0;
+    }
+    if (!token->flags.value_escaped) {
+        return src_len == len && !memcmp(src, str, len);
+    }
+    while (s < src_len) {
+        size_t n = prv_find_escape(&src[s], src_len - s), esc_len;
+        char esc[4];
+
+        if (n > len - d || memcmp(&src[s], &str[d], n)) {
+            return 0;
+        }
+        s += n;
+        d += n;
+        if (s == src_len) {
+            break;
+        }
+        s += prv_decode_escape(&src[s], src_len - s, esc, &esc_len);
+        if (esc_len > len - d || memcmp(esc, &str[d], esc_len)) {
+            return 0;
+        }
+        d += esc_len;
+    }
+    return d == len;
+}
+
+/**
+ * \brief           Create path segment from input path for search operation
+ * \param[in,out]   ppath: Pointer to pointer to input path. Pointer is modified
+ * \param[out]      opath: Pointer to pointer to write path segment
+ * \param[out]      olen: Pointer to variable to write length of segment
+ * \param[out]      is_last: Pointer to write if this is last segment
+ * \return          `1` on success, `0` otherwise
+ */
+static uint8_t
+prv_create_path_segment(const char** ppath, const char** opath, size_t* olen, uint8_t* is_last) {
+    const char* segment = *ppath;
+
+    *is_last = 0;
+    *opath = NULL;
+    *olen = 0;
+
+    /* Check input path */
+    if (segment == NULL || *segment == '\0') {
+        *is_last = 1;
+        return 0;
+    }
+
+    /*
+     * Path must be one of:
+     * - literal text
+     * - "#" followed by dot "."
+     */
+    if (*segment == '#') {
+        *opath = segment;
+        for (*olen = 0;; ++segment, ++(*olen)) {
+            if (*segment == '.') {
+                ++segment;
+                break;
+            } else if (*segment == '\0') {
+                if (*olen == 1) {
+                    return 0;
+                } else {
+                    break;
+                }
+            }
+        }
+        *ppath = segment;
+    } else {
+        *opath = segment;
+        for (*olen = 0; *segment != '\0' && *segment != '.'; ++(*olen), ++segment) {}
+        *ppath = segment + 1;
+    }
+    if (*segment == '\0') {
+        *is_last = 1;
+    }
+    return 1;
+}
+
+/**
+ * \brief           Calculate hash of the key name, with FNV-1a algorithm
+ * \param[in]       name: Key name
+ * \param[in]       len: Length of key name
+ * \return          Hash value
+ */
+static uint32_t
+prv_key_hash(const char* name, size_t len) {
+    uint32_t hash = 0x811C9DC5U;
+
+    for (size_t i = 0; i < len; ++i) {
+        hash = (hash ^ (uint8_t)name[i]) * 0x01000193U;
+    }
+    return hash;
+}
+
+/**
+ * \brief           Parse next segment of input path to key name or array index
+ * \param[in,out]   ppath: Pointer to pointer to input path. Pointer is moved to the next segment
+ * \param[out]      seg: Pointer to write parsed segment to
+ * \param[out]      is_last: Pointer to write if this is last segment
+ * \return          `1` on success, `0` if segment is invalid
+ */
+static uint8_t
+prv_path_segment(const char** ppath, lwjson_path_segment_t* seg, uint8_t* is_last) {
+    const char* segment;
+    size_t segment_len;
+
+    if (!prv_create_path_segment(ppath, &segment, &segment_len, is_last)) {
+        return 0;
+    }
+    if (*segment == '#') {
+        seg->type = segment_len == 1 ? LWJSON_PATH_ANY : LWJSON_PATH_INDEX;
+        seg->index = 0;
+        for (size_t i = 1; i < segment_len; ++i) {
+            /* Index out of range of `size_t` cannot refer to any element */
+            if (segment[i] < '0' || segment[i] > '9' || seg->index > (SIZE_MAX - (size_t)(segment[i] - '0')) / 10) {
+                return 0;
+            }
+            seg->index = seg->index * 10 + (segment[i] - '0');
+        }
+    } else {
+        seg->type = LWJSON_PATH_KEY;
+        seg->name = segment;
+        seg->name_len = segment_len;
+        seg->hash = prv_key_hash(segment, segment_len);
+    }
+    return 1;
+}
+
+/**
+ * \brief           Get child of array token at index
+ * \param[in]       parent: Array token
+ * \param[in]       index: Index of the child
+ * \return          Child token on success, `NULL` if index is out of range
+ */
+static const lwjson_token_t*
+prv_get_child_at(const lwjson_token_t* parent, size_t index) {
+    const lwjson_token_t* tkn;
+
+#if LWJSON_CFG_CHILD_INDEX
+    if (index >= parent->child_cnt) {
+        return NULL;
+    }
+    if (parent->child_index != NULL) {
+        return parent->child_index[index];
+    }
+#endif /* LWJSON_CFG_CHILD_INDEX */
+
+    /* Start from beginning */
+    for (tkn = lwjson_get_first_child(parent); tkn != NULL && index > 0; tkn = lwjson_get_next(tkn), --index) {}
+    return tkn;
+}
+
+/**
+ * \brief           Get next child of object token with the key name
+ *
+ * Children are returned in order of the object.
+ * Hash table of the object is probed when available, all children are compared otherwise.
+ *
+ * \param[in]       lwobj: LwJSON instance
+ * \param[in]       parent: Object token
+ * \param[in]       name: Key name to search for
+ * \param[in]       len: Length of key name in units of bytes
+ * \param[in]       hash: Hash of key name, as calculated by \ref prv_key_hash
+ * \param[in]       start: Child found by previous call to continue the search after,
+ *                      `NULL` to start with the first child
+ * \return          Child token on success, `NULL` if there are no more children with the name
+ */
+static const lwjson_token_t*
+prv_find_key_child(const lwjson_t* lwobj, const lwjson_token_t* parent, const char* name, size_t len,
+                   uint32_t hash, const lwjson_token_t* start) {
+    const lwjson_token_t* tkn;
+
+#if LWJSON_CFG_KEY_INDEX
+    if (parent->key_index != NULL) {
+        size_t mask = parent->key_index_len - 1;
+
+        /* Children with the same hash are probed in the order of the object, skip the ones already returned */
+        for (size_t i = hash & mask; (tkn = parent->key_index[i]) != NULL; i = (i + 1) & mask) {
+            if (start != NULL) {
+                if (tkn == start) {
+                    start = NULL;
+                }
+            } else if (tkn->token_name_len == len && !strncmp(tkn->token_name, name, len)) {
+                return tkn;
+            }
+        }
+        return NULL;
+    }
+#else
+    (void)hash;
+#endif /* LWJSON_CFG_KEY_INDEX */
+    for (tkn = start != NULL ? lwjson_get_next(start) : lwjson_get_first_child(parent); tkn != NULL;
+         tkn = lwjson_get_next(tkn)) {
+        if (tkn->token_name_len == len && !strncmp(lwjson_get_name(lwobj, tkn, NULL), name, len)) {
+            return tkn;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * \brief           Input recursive function for find operation
+ * \param[in]       lwobj: LwJSON instance
+ * \param[in]       parent: Parent token of type \ref LWJSON_TYPE_ARRAY or LWJSON_TYPE_OBJECT
+ * \param[in]       path: Path to search for starting this token further
+ * \return          Found token on success, `NULL` otherwise
+ */
+static const lwjson_token_t*
+prv_find(const lwjson_t* lwobj, const lwjson_token_t* parent, const char* path) {
+    lwjson_path_segment_t seg;
+    uint8_t is_last;
+
+    /* Get path segments */
+    if (!prv_path_segment(&path, &seg, &is_last)) {
+        return NULL;
+    }
+    if (seg.type == LWJSON_PATH_KEY) {
+        if (parent->type != LWJSON_TYPE_OBJECT) {
+            return NULL;
+        }
+        for (const lwjson_token_t* tkn = prv_find_key_child(lwobj, parent, seg.name, seg.name_len, seg.hash, NULL);
+             tkn != NULL; tkn = prv_find_key_child(lwobj, parent, seg.name, seg.name_len, seg.hash, tkn)) {
+            const lwjson_token_t* tmp;
+            if (is_last) {
+                return tkn;
+            }
+            tmp = prv_find(lwobj, tkn, path);
+            if (tmp != NULL) {
+                return tmp;
+            }
+        }
+        return NULL;
+    }
+
+    /* Parent must be array */
+    if (parent->type != LWJSON_TYPE_ARRAY) {
+        return NULL;
+    }
+    if (seg.type == LWJSON_PATH_INDEX) {
+        const lwjson_token_t* tkn = prv_get_child_at(parent, seg.index);
+        if (tkn == NULL || is_last) {
+            return tkn;
+        }
+        return prv_find(lwobj, tkn, path);
+    }
+
+    /* Scan all indexes and get first match */
+    for (const lwjson_token_t* tkn = lwjson_get_first_child(parent); tkn != NULL; tkn = lwjson_get_next(tkn)) {
+        const lwjson_token_t* tmp = prv_find(lwobj, tkn, path);
+        if (tmp != NULL) {
+            return tmp;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * \brief           Check for character after opening bracket of array or object
+ * \param[in,out]   pobj: JSON string
+ * \param[in]       type: Type of opened object, \ref LWJSON_TYPE_OBJECT or \ref LWJSON_TYPE_ARRAY
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+static inline lwjsonr_t
+prv_check_valid_char_after_open_bracket(lwjson_int_str_t* pobj, lwjson_type_t type) {
+    lwjsonr_t res;
+
+    /* Check next character after object open */
+    res = prv_skip_blank(pobj);
+    if (res != lwjsonOK) {
+        return res;
+    }
+    if ((type == LWJSON_TYPE_OBJECT && (*pobj->p != '"' && *pobj->p != '}'))
+        || (type == LWJSON_TYPE_ARRAY
+            && (*pobj->p != '"' && *pobj->p != ']' && *pobj->p != '[' && *pobj->p != '{' && *pobj->p != '-'
+                && (*pobj->p < '0' || *pobj->p > '9') && *pobj->p != 't' && *pobj->p != 'n' && *pobj->p != 'f'))) {
+        res = lwjsonERRJSON;
+    }
+    return res;
+}
+
+/**
+ * \brief           Setup LwJSON instance for parsing JSON strings
+ * \note            Array of tokens is not cleared, every token is initialized when it is used by the parser
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in]       tokens: Pointer to array of tokens used for parsing
+ * \param[in]       tokens_len: Number of tokens
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_init(lwjson_t* lwobj, lwjson_token_t* tokens, size_t tokens_len) {
+    LWJSON_MEMSET(lwobj, 0x00, sizeof(*lwobj));
+#if LWJSON_CFG_ARENA
+    if (tokens == NULL) {
+        tokens_len = 0;
+    }
+    lwobj->arena_len = tokens_len;
+#endif /* LWJSON_CFG_ARENA */
+    lwobj->tokens = tokens;
+    lwobj->tokens_len = tokens_len;
+#if !LWJSON_CFG_COMPACT_TOKEN
+    lwobj->first_token.type = LWJSON_TYPE_OBJECT;
+#endif /* !LWJSON_CFG_COMPACT_TOKEN */
+    return lwjsonOK;
+}
+
+#if LWJSON_CFG_CHILD_INDEX
+
+/**
+ * \brief           Set buffer for direct access tables of array children
+ * \note            Buffer is used by all following parse operations, until set again.
+ *                  Set it to `NULL` to disable tables
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in]       index: Pointer to array of token pointers
+ * \param[in]       index_len: Number of entries in the array
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_set_index(lwjson_t* lwobj, lwjson_token_t** index, size_t index_len) {
+    if (lwobj == NULL) {
+        return lwjsonERRPAR;
+    }
+    lwobj->index = index;
+    lwobj->index_len = index != NULL ? index_len : 0;
+    lwobj->next_free_index_pos = 0;
+    return lwjsonOK;
+}
+
+/**
+ * \brief           Build direct access table of children for array token
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in,out]   t: Array token with all children parsed
+ */
+static void
+prv_build_child_index(lwjson_t* lwobj, lwjson_token_t* t) {
+    lwjson_token_t** index;
+
+    if (t->type != LWJSON_TYPE_ARRAY || t->child_cnt < LWJSON_CFG_CHILD_INDEX_MIN_CNT
+        || t->child_cnt > lwobj->index_len - lwobj->next_free_index_pos) {
+        return;
+    }
+    index = &lwobj->index[lwobj->next_free_index_pos];
+    lwobj->next_free_index_pos += t->child_cnt;
+    t->child_index = index;
+    for (lwjson_token_t* c = t->u.first_child; c != NULL; c = c->next) {
+        *index++ = c;
+    }
+}
+#endif /* LWJSON_CFG_CHILD_INDEX */
+
+#if LWJSON_CFG_KEY_INDEX
+
+/**
+ * \brief           Set buffer for hash tables of object keys
+ * \note            Buffer is used by all following parse operations, until set again.
+ *                  Set it to `NULL` to disable tables
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in]       index: Pointer to array of token pointers
+ * \param[in]       index_len: Number of entries in the array
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_set_key_index(lwjson_t* lwobj, lwjson_token_t** index, size_t index_len) {
+    if (lwobj == NULL) {
+        return lwjsonERRPAR;
+    }
+    lwobj->key_index = index;
+    lwobj->key_index_len = index != NULL ? index_len : 0;
+    lwobj->next_free_key_index_pos = 0;
+    return lwjsonOK;
+}
+
+/**
+ * \brief           Build hash table of keys for object token
+ *
+ * Table uses linear probing, hence children with the same name
+ * are found in the same order as they are in the object.
+ *
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in,out]   t: Object token with all children parsed
+ */
+static void
+prv_build_key_index(lwjson_t* lwobj, lwjson_token_t* t) {
+    lwjson_token_t** index;
+    size_t cnt = 0, len;
+
+    if (t->type != LWJSON_TYPE_OBJECT) {
+        return;
+    }
+#if LWJSON_CFG_CHILD_INDEX
+    cnt = t->child_cnt;
+#else
+    for (lwjson_token_t* c = t->u.first_child; c != NULL; c = c->next) {
+        ++cnt;
+    }
+#endif /* !LWJSON_CFG_CHILD_INDEX */
+    if (cnt < LWJSON_CFG_KEY_INDEX_MIN_CNT) {
+        return;
+    }
+    for (len = 1; len < 2 * cnt; len <<= 1) {}
+    if (len > lwobj->key_index_len - lwobj->next_free_key_index_pos) {
+        return;
+    }
+    index = &lwobj->key_index[lwobj->next_free_key_index_pos];
+    lwobj->next_free_key_index_pos += len;
+    LWJSON_MEMSET(index, 0x00, len * sizeof(*index));
+    for (lwjson_token_t* c = t->u.first_child; c != NULL; c = c->next) {
+        size_t i = prv_key_hash(c->token_name, c->token_name_len) & (len - 1);
+
+        while (index[i] != NULL) {
+            i = (i + 1) & (len - 1);
+        }
+        index[i] = c;
+    }
+    t->key_index = index;
+    t->key_index_len = len;
+}
+
+#endif /* LWJSON_CFG_KEY_INDEX */
+
+#if LWJSON_CFG_SELECTIVE
+
+/**
+ * \brief           Skip value without parsing it to tokens
+ *
+ * Strings are checked as in regular parsing, while for objects and arrays only balance of brackets is checked.
+ * Other characters of skipped value are not validated.
+ * Characters between strings and brackets are jumped over with block bitmaps
+ * when \ref LWJSON_CFG_STRUCT_INDEX is enabled, and scanned one by one otherwise.
+ *
+ * \param[in,out]   pobj: JSON string, at the first character of the value
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+static lwjsonr_t
+prv_skip_value(lwjson_int_str_t* pobj) {
+    lwjsonr_t res;
+    size_t depth = 0;
+
+    do {
+        if ((size_t)(pobj->p - pobj->start) >= pobj->len) {
+            return lwjsonERRJSON;
+        }
+        switch (*pobj->p) {
+            case '"': {
+                const char* str;
+                size_t str_len;
+                uint8_t escaped;
+
+                res = prv_parse_string(pobj, &str, &str_len, &escaped);
+                if (res != lwjsonOK) {
+                    return res;
+                }
+                break;
+            }
+            case '{':
+            case '[':
+                ++depth;
+                ++pobj->p;
+                break;
+            case '}':
+            case ']':
+                if (depth == 0) {
+                    return lwjsonERRJSON;
+                }
+                --depth;
+                ++pobj->p;
+                break;
+#if LWJSON_CFG_COMMENTS
+            case '/':
+                if (prv_skip_blank(pobj) != lwjsonOK) {
+                    return lwjsonERRJSON;
+                }
+                break;
+#endif /* LWJSON_CFG_COMMENTS */
+            default:
+                if (depth == 0) {
+                    const char* start = pobj->p;
+
+                    /* Primitive value ends at separator or blank character */
+                    for (; (size_t)(pobj->p - pobj->start) < pobj->len; ++pobj->p) {
+                        char ch = *pobj->p;
+
+                        if (ch == ',' || ch == '}' || ch == ']' || ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n'
+                            || ch == '\f' || ch == '/') {
+                            break;
+                        }
+                    }
+                    return pobj->p != start ? lwjsonOK : lwjsonERRJSON;
+                }
+
+                /* Jump to the next character that changes the depth */
+#if LWJSON_CFG_STRUCT_INDEX && !LWJSON_CFG_COMMENTS
+                ++pobj->p;
+                prv_blk_skip_to_bracket(pobj);
+#else
+                for (++pobj->p; (size_t)(pobj->p - pobj->start) < pobj->len; ++pobj->p) {
+                    char ch = *pobj->p;
+
+                    if (ch == '"' || ch == '{' || ch == '}' || ch == '[' || ch == ']' || ch == '/') {
+                        break;
+                    }
+                }
+#endif /* LWJSON_CFG_STRUCT_INDEX && !LWJSON_CFG_COMMENTS */
+                break;
+        }
+    } while (depth > 0);
+    return lwjsonOK;
+}
+
+/**
+ * \brief           Check if value of current container is on any of selected paths
+ * \param[in,out]   sel: Selective parsing context, at depth of the container
+ * \param[in]       to: Container token
+ * \param[in]       name: Name of the value, used when container is object
+ * \param[in]       name_len: Length of the name
+ * \param[out]      keep_pos: Set to `1` when skipped value keeps position of array element for later index
+ * \return          `1` if value shall be parsed to tokens, `0` if it shall be skipped
+ */
+static uint8_t
+prv_select_value(lwjson_int_select_t* sel, const lwjson_token_t* to, const char* name, size_t name_len,
+                 uint8_t* keep_pos) {
+    size_t depth = sel->depth, pos = 0;
+
+    sel->sub = 0;
+    sel->is_all = 0;
+    *keep_pos = 0;
+    if (to->type == LWJSON_TYPE_ARRAY) {
+        pos = sel->pos[depth]++;
+    }
+    for (uint64_t m = sel->masks[depth]; m != 0; m &= m - 1) {
+        uint32_t i = prv_ctz64(m);
+        const lwjson_path_segment_t* seg = &sel->paths[i].segments[depth];
+        uint8_t match;
+
+        if (seg->type == LWJSON_PATH_KEY) {
+            match = to->type == LWJSON_TYPE_OBJECT && seg->name_len == name_len
+                    && !strncmp(name, seg->name, name_len);
+        } else if (to->type != LWJSON_TYPE_ARRAY) {
+            match = 0;
+        } else if (seg->type == LWJSON_PATH_INDEX) {
+            match = seg->index == pos;
+            *keep_pos |= seg->index > pos;
+        } else {
+            match = 1;
+        }
+        if (match) {
+            if (depth + 1 == sel->paths[i].segments_cnt) {
+                sel->is_all = 1;
+            } else {
+                sel->sub |= (uint64_t)1 << i;
+            }
+        }
+    }
+    if (sel->is_all || sel->sub != 0) {
+        *keep_pos = 0;
+        return 1;
+    }
+    return 0;
+}
+
+#endif /* LWJSON_CFG_SELECTIVE */
+
+/**
+ * \brief           Parse JSON object or array to tokens
+ *
+ * Parsing stops right after closing bracket of root object or array,
+ * or at the end of input data, when root is not closed.
+ *
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in,out]   in: Prepared JSON string. Set to the last parsed position on return
+ * \param[out]      is_closed: Set to `1` when root object or array is closed, `0` otherwise
+ * \param[in]       is_part: Set to `1` to parse chunk of root array, starting with opening bracket or comma
+ * \param[in,out]   sel: Selective parsing context, set to `NULL` to parse all values
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+static lwjsonr_t
+prv_parse_tokens(lwjson_t* lwobj, lwjson_int_str_t* in, uint8_t* is_closed, uint8_t is_part,
+                 lwjson_int_select_t* sel) {
+    lwjsonr_t res = lwjsonOK;
+    lwjson_token_t *t, *to, *root, *last = NULL;
+    lwjson_int_str_t pobj = *in;
+    const char* name = NULL;
+    size_t name_len = 0;
+    uint8_t name_escaped = 0;
+#if LWJSON_CFG_SELECTIVE
+    uint8_t keep_pos = 0;
+#else
+    (void)sel;
+#endif /* !LWJSON_CFG_SELECTIVE */
+
+    /* values from very beginning */
+    lwjson_reset(lwobj);
+    *is_closed = 0;
+
+    /* set first token */
+#if LWJSON_CFG_COMPACT_TOKEN
+    if (pobj.len > UINT32_MAX) {
+        res = lwjsonERRPAR;
+        goto ret;
+    }
+    lwobj->json_data = pobj.start;
+    to = prv_alloc_token(lwobj);
+    if (to == NULL) {
+        res = lwjsonERRMEM;
+        goto ret;
+    }
+#else
+    to = &lwobj->first_token;
+    LWJSON_MEMSET(to, 0x00, sizeof(*to));
+#endif /* !LWJSON_CFG_COMPACT_TOKEN */
+    root = to;
+
+    /* First parse */
+    res = prv_skip_blank(&pobj);
+    if (res != lwjsonOK) {
+        goto ret;
+    }
+    if (*pobj.p == '{' && !is_part) {
+        to->type = LWJSON_TYPE_OBJECT;
+    } else if (*pobj.p == '[' || (*pobj.p == ',' && is_part)) {
+        to->type = LWJSON_TYPE_ARRAY;
+    } else {
+        res = lwjsonERRJSON;
+        goto ret;
+    }
+    if (*pobj.p++ == ',') {
+        /* Chunk continues after separator, the same as main loop below, after value of previous chunk */
+        lwobj->flags.part_sep = 1;
+    } else {
+        if (is_part) {
+            prv_skip_blank(&pobj);
+            if ((size_t)(pobj.p - pobj.start) == pobj.len) {
+                goto ret;
+            }
+        }
+        res = prv_check_valid_char_after_open_bracket(&pobj, to->type);
+        if (res != lwjsonOK) {
+            goto ret;
+        }
+    }
+
+    /* Process all characters as indicated by input user */
+    while (!prv_str_is_end(&pobj)) {
+        /* Filter out blanks, chunk of root array may end with them */
+        res = prv_skip_blank(&pobj);
+        if (res != lwjsonOK) {
+            if (is_part && (size_t)(pobj.p - pobj.start) == pobj.len) {
+                res = lwjsonOK;
+                break;
+            }
+            goto ret;
+        }
+        if (*pobj.p == ',') {
+            ++pobj.p;
+            continue;
+        }
+
+        /* Check if end of object or array*/
+        if (*pobj.p == (to->type == LWJSON_TYPE_OBJECT ? '}' : ']')) {
+#if LWJSON_CFG_COMPACT_TOKEN
+            lwjson_token_t* parent = to == root ? NULL : &lwobj->tokens[to->u.tokens_cnt];
+            to->u.tokens_cnt = (uint32_t)(lwobj->next_free_token_pos - (size_t)(to - lwobj->tokens) - 1);
+#else
+            lwjson_token_t* parent = to->next;
+            to->next = NULL;
+#endif /* !LWJSON_CFG_COMPACT_TOKEN */
+            ++pobj.p;
+#if LWJSON_CFG_CHILD_INDEX
+            prv_build_child_index(lwobj, to);
+#endif /* LWJSON_CFG_CHILD_INDEX */
+#if LWJSON_CFG_KEY_INDEX
+            prv_build_key_index(lwobj, to);
+#endif /* LWJSON_CFG_KEY_INDEX */
+
+            /* Closed object or array is the last child of its parent */
+            last = to;
+
+            /* End of string if to == NULL (no parent) */
+            to = parent;
+            if (to == NULL) {
+                *is_closed = 1;
+                goto ret;
+            }
+#if LWJSON_CFG_SELECTIVE
+            if (sel != NULL) {
+                if (sel->depth == sel->keep_depth) {
+                    sel->keep_depth = SIZE_MAX;
+                }
+                --sel->depth;
+            }
+#endif /* LWJSON_CFG_SELECTIVE */
+            continue;
+        }
+
+        /* If object type is not array, first thing is property that starts with quotes */
+        if (to->type != LWJSON_TYPE_ARRAY) {
+            if (*pobj.p != '"') {
+                res = lwjsonERRJSON;
+                goto ret;
+            }
+            res = prv_parse_property_name(&pobj, &name, &name_len, &name_escaped);
+            if (res != lwjsonOK) {
+                goto ret;
+            }
+#if LWJSON_CFG_INSITU
+            if (pobj.insitu) {
+                prv_insitu_string(name, &name_len, &name_escaped);
+            }
+#endif /* LWJSON_CFG_INSITU */
+        }
+
+#if LWJSON_CFG_SELECTIVE
+        /* Values not on selected paths are skipped, array elements before selected index are kept as placeholders */
+        keep_pos = 0;
+        if (sel != NULL && sel->depth < sel->keep_depth && !prv_select_value(sel, to, name, name_len, &keep_pos)
+            && !keep_pos) {
+            res = prv_skip_value(&pobj);
+            if (res == lwjsonOK) {
+                res = prv_check_after_value(&pobj);
+            }
+            if (res != lwjsonOK) {
+                goto ret;
+            }
+            continue;
+        }
+#endif /* LWJSON_CFG_SELECTIVE */
+
+        /* Allocate new token */
+        t = prv_alloc_token(lwobj);
+        if (t == NULL) {
+            res = lwjsonERRMEM;
+            goto ret;
+        }
+        if (to->type != LWJSON_TYPE_ARRAY) {
+#if LWJSON_CFG_COMPACT_TOKEN
+            if (name_len > UINT16_MAX) {
+                res = lwjsonERRPAR;
+                goto ret;
+            }
+            t->token_name_off = (uint32_t)(name - pobj.start);
+            t->token_name_len = (uint16_t)name_len;
+#else
+            t->token_name = name;
+            t->token_name_len = name_len;
+#endif /* !LWJSON_CFG_COMPACT_TOKEN */
+            t->flags.name_escaped = name_escaped;
+        }
+
+        /* Add element to the end of linked list */
+#if LWJSON_CFG_COMPACT_TOKEN
+        if (last != NULL) {
+            last->flags.has_next = 1;
+        }
+#else
+        if (last == NULL) {
+            to->u.first_child = t;
+        } else {
+            last->next = t;
+        }
+#endif /* !LWJSON_CFG_COMPACT_TOKEN */
+        last = t;
+#if LWJSON_CFG_CHILD_INDEX
+        ++to->child_cnt;
+#endif /* LWJSON_CFG_CHILD_INDEX */
+
+#if LWJSON_CFG_SELECTIVE
+        if (keep_pos) {
+            t->type = LWJSON_TYPE_SKIPPED;
+            res = prv_skip_value(&pobj);
+            if (res == lwjsonOK) {
+                res = prv_check_after_value(&pobj);
+            }
+            if (res != lwjsonOK) {
+                goto ret;
+            }
+            continue;
+        }
+#endif /* LWJSON_CFG_SELECTIVE */
+
+        /* Check next character to process */
+        switch (*pobj.p) {
+            case '{':
+            case '[':
+                t->type = *pobj.p == '{' ? LWJSON_TYPE_OBJECT : LWJSON_TYPE_ARRAY;
+                ++pobj.p;
+
+                res = prv_check_valid_char_after_open_bracket(&pobj, t->type);
+                if (res != lwjsonOK) {
+                    goto ret;
+                }
+#if LWJSON_CFG_COMPACT_TOKEN
+                t->u.tokens_cnt = (uint32_t)(to - lwobj->tokens); /* Temporary saved as parent object index */
+#else
+                t->next = to; /* Temporary saved as parent object */
+#endif /* !LWJSON_CFG_COMPACT_TOKEN */
+                to = t;
+                last = NULL;
+#if LWJSON_CFG_SELECTIVE
+                if (sel != NULL && sel->depth++ < sel->keep_depth) {
+                    if (sel->is_all) {
+                        sel->keep_depth = sel->depth;
+                    } else {
+                        sel->masks[sel->depth] = sel->sub;
+                        sel->pos[sel->depth] = 0;
+                    }
+                }
+#endif /* LWJSON_CFG_SELECTIVE */
+                break;
+            case '"': {
+                uint8_t escaped;
+#if LWJSON_CFG_COMPACT_TOKEN
+                const char* str;
+                size_t str_len;
+
+                res = prv_parse_string(&pobj, &str, &str_len, &escaped);
+#if LWJSON_CFG_INSITU
+                if (res == lwjsonOK && pobj.insitu) {
+                    prv_insitu_string(str, &str_len, &escaped);
+                }
+#endif /* LWJSON_CFG_INSITU */
+                t->u.str.token_value_off = (uint32_t)(str - pobj.start);
+                t->u.str.token_value_len = (uint32_t)str_len;
+#else
+                res = prv_parse_string(&pobj, &t->u.str.token_value, &t->u.str.token_value_len, &escaped);
+#if LWJSON_CFG_INSITU
+                if (res == lwjsonOK && pobj.insitu) {
+                    prv_insitu_string(t->u.str.token_value, &t->u.str.token_value_len, &escaped);
+                }
+#endif /* LWJSON_CFG_INSITU */
+#endif /* !LWJSON_CFG_COMPACT_TOKEN */
+                if (res == lwjsonOK) {
+                    t->type = LWJSON_TYPE_STRING;
+                    t->flags.value_escaped = escaped;
+                } else {
+                    goto ret;
+                }
+                break;
+            }
+            case 't':
+            case 'f':
+            case 'n': {
+                lwjson_type_t type;
+
+                res = prv_parse_literal(&pobj, &type);
+                if (res != lwjsonOK) {
+                    goto ret;
+                }
+                t->type = type;
+                break;
+            }
+            default:
+                if (*pobj.p == '-' || (*pobj.p >= '0' && *pobj.p <= '9')) {
+                    lwjson_type_t type;
+
+#if LWJSON_CFG_LAZY_NUMBER
+                    res = prv_scan_number(&pobj, &type, &t->u.str.token_value);
+                    t->u.str.token_value_len = (size_t)(pobj.p - t->u.str.token_value);
+#else
+                    res = prv_parse_number(&pobj, &type, &t->u.num_real, &t->u.num_int);
+#endif /* !LWJSON_CFG_LAZY_NUMBER */
+                    if (res != lwjsonOK) {
+                        goto ret;
+                    }
+                    t->type = type;
+                } else {
+                    res = lwjsonERRJSON;
+                    goto ret;
+                }
+                break;
+        }
+
+        /* Below code is used to check characters after valid tokens */
+        if (t->type == LWJSON_TYPE_ARRAY || t->type == LWJSON_TYPE_OBJECT) {
+            continue;
+        }
+
+        /* Check what are values after the token value, chunk of root array may end after any value */
+        if (is_part) {
+            prv_skip_blank(&pobj);
+            if ((size_t)(pobj.p - pobj.start) == pobj.len) {
+                continue;
+            }
+        }
+        res = prv_check_after_value(&pobj);
+        if (res != lwjsonOK) {
+            goto ret;
+        }
+    }
+#if LWJSON_CFG_COMPACT_TOKEN
+    if (to != root) {
+#else
+    if (to != root || (to != NULL && to->next != NULL)) {
+#endif /* !LWJSON_CFG_COMPACT_TOKEN */
+        res = lwjsonERRJSON;
+        to = NULL;
+    }
+    if (to != NULL) {
+        if (to->type != LWJSON_TYPE_ARRAY && to->type != LWJSON_TYPE_OBJECT) {
+            res = lwjsonERRJSON;
+        }
+#if LWJSON_CFG_COMPACT_TOKEN
+        to->u.tokens_cnt = (uint32_t)(lwobj->next_free_token_pos - 1);
+#else
+        to->token_name = NULL;
+        to->token_name_len = 0;
+        lwobj->last_child = last;
+#endif /* !LWJSON_CFG_COMPACT_TOKEN */
+    }
+ret:
+    *in = pobj;
+    return res;
+}
+
+/* Options of complete JSON data parsing */
+#define LWJSON_INT_PARSE_INSITU 0x01 /* Decode names and string values in place of writable input data */
+#define LWJSON_INT_PARSE_PADDED 0x02 /* Input is followed by zero padding and may contain NUL characters */
+
+/**
+ * \brief           Parse complete JSON data
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in]       json_data: JSON string to parse
+ * \param[in]       json_len: JSON data length
+ * \param[in,out]   sel: Selective parsing context, set to `NULL` to parse all values
+ * \param[in]       flags: Parsing options, set of `LWJSON_INT_PARSE_*` values
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+static lwjsonr_t
+prv_parse(lwjson_t* lwobj, const void* json_data, size_t json_len, lwjson_int_select_t* sel, uint8_t flags) {
+    lwjsonr_t res;
+    uint8_t is_closed;
+    lwjson_int_str_t pobj = {.start = json_data, .len = json_len, .p = json_data};
+
+    if (flags & LWJSON_INT_PARSE_PADDED) {
+        /* Input does not end at NUL character, and zero padding is available to multi-byte loads */
+        pobj.readable = json_len + LWJSON_PADDING;
+#if LWJSON_CFG_STRUCT_INDEX
+        pobj.blk.pos = SIZE_MAX;
+#endif /* LWJSON_CFG_STRUCT_INDEX */
+    } else {
+        prv_str_init(&pobj);
+    }
+#if LWJSON_CFG_INSITU
+    pobj.insitu = (flags & LWJSON_INT_PARSE_INSITU) ? 1 : 0;
+#endif /* LWJSON_CFG_INSITU */
+    res = prv_parse_tokens(lwobj, &pobj, &is_closed, 0, sel);
+
+    /* Root must be closed, check if properly terminated after it */
+    if (res == lwjsonOK && !is_closed) {
+        res = lwjsonERRJSON;
+    } else if (res == lwjsonOK) {
+        prv_skip_blank(&pobj);
+        res = prv_str_is_end(&pobj) ? lwjsonOK : lwjsonERR;
+    }
+    if (res == lwjsonOK) {
+        lwobj->flags.parsed = 1;
+    }
+    return res;
+}
+
+/**
+ * \brief           Parse JSON data with length parameter
+ * JSON format must be complete and must comply with RFC4627
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in]       json_data: JSON string to parse
+ * \param[in]       jsonČlen: JSON data length
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_parse_ex(lwjson_t* lwobj, const void* json_data, size_t json_len) {
+    /* Check input parameters */
+    if (lwobj == NULL || json_data == NULL || json_len == 0) {
+        return lwjsonERRPAR;
+    }
+    return prv_parse(lwobj, json_data, json_len, NULL, 0);
+}
+
+/**
+ * \brief           Parse input JSON format
+ * JSON format must be complete and must comply with RFC4627
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in]       json_str: JSON string to parse
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_parse(lwjson_t* lwobj, const char* json_str) {
+    return lwjson_parse_ex(lwobj, json_str, strlen(json_str));
+}
+
+#if LWJSON_CFG_SELECTIVE
+
+/**
+ * \brief           Parse only values on selected paths
+ *
+ * Tokens are created only for objects and arrays on the way to selected paths, and for selected values,
+ * which are parsed with all their children. All other values are skipped,
+ * with only strings and balance of brackets checked.
+ * Array elements before selected index are kept as tokens of \ref LWJSON_TYPE_SKIPPED type,
+ * hence find functions give the same results for selected paths as after full parsing.
+ *
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in]       json_data: JSON string to parse
+ * \param[in]       json_len: JSON data length
+ * \param[in]       paths: Array of paths compiled with \ref lwjson_path_compile
+ * \param[in]       paths_cnt: Number of paths, up to `64`
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_parse_selective(lwjson_t* lwobj, const void* json_data, size_t json_len, const lwjson_path_t* paths,
+                       size_t paths_cnt) {
+    lwjson_int_select_t sel = {.paths = paths, .keep_depth = SIZE_MAX};
+
+    if (lwobj == NULL || json_data == NULL || json_len == 0 || paths == NULL || paths_cnt > 64) {
+        return lwjsonERRPAR;
+    }
+    for (size_t i = 0; i < paths_cnt; ++i) {
+        if (paths[i].segments_cnt == 0) {
+            sel.keep_depth = 0;
+        } else {
+            sel.masks[0] |= (uint64_t)1 << i;
+        }
+    }
+    return prv_parse(lwobj, json_data, json_len, &sel, 0);
+}
+
+#endif /* LWJSON_CFG_SELECTIVE */
+
+#if LWJSON_CFG_INSITU
+
+/**
+ * \brief           Parse writable JSON data in place
+ *
+ * Escape sequences of property names and string values are decoded to UTF-8 in place of input data,
+ * and every name and string value is terminated with `NULL` character, on the position of its closing quote.
+ * Tokens point to decoded strings, that can be used directly as C strings.
+ *
+ * \note            Input data is modified and cannot be parsed again. It must stay valid while tokens are used
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in,out]   json_data: Writable JSON string to parse
+ * \param[in]       json_len: JSON data length
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_parse_insitu(lwjson_t* lwobj, char* json_data, size_t json_len) {
+    if (lwobj == NULL || json_data == NULL || json_len == 0) {
+        return lwjsonERRPAR;
+    }
+    return prv_parse(lwobj, json_data, json_len, NULL, LWJSON_INT_PARSE_INSITU);
+}
+
+#endif /* LWJSON_CFG_INSITU */
+
+/**
+ * \brief           Parse JSON data, followed by zero padding
+ *
+ * Input data must be followed by \ref LWJSON_PADDING readable bytes set to zero, not included in `json_len`.
+ * End of input is known from its length only, and multi-byte loads may read padding without checks.
+ * `NULL` character inside of string is part of the string, anywhere else it is invalid JSON.
+ *
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in]       json_data: JSON data to parse, followed by \ref LWJSON_PADDING zero bytes
+ * \param[in]       json_len: JSON data length, without padding
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_parse_padded(lwjson_t* lwobj, const void* json_data, size_t json_len) {
+    if (lwobj == NULL || json_data == NULL || json_len == 0) {
+        return lwjsonERRPAR;
+    }
+    return prv_parse(lwobj, json_data, json_len, NULL, LWJSON_INT_PARSE_PADDED);
+}
+
+/**
+ * \brief           Find end of malformed document, to continue with the next one
+ *
+ * Document ends after closing bracket, that matches its first opening bracket.
+ * When document does not start with a bracket, or brackets are not balanced until the end of data,
+ * document ends at the end of its line instead.
+ *
+ * \param[in]       pobj: JSON string, starting at first character of the document
+ * \return          Length of the document
+ */
+static size_t
+prv_find_doc_end(const lwjson_int_str_t* pobj) {
+    const char* nl;
+    size_t depth = 0;
+
+    if (pobj->start[0] == '{' || pobj->start[0] == '[') {
+        for (size_t i = 0; i < pobj->len; ++i) {
+            char c = pobj->start[i];
+
+            if (c == '"') {
+                for (++i; i < pobj->len && pobj->start[i] != '"'; ++i) {
+                    i += pobj->start[i] == '\\' ? 1 : 0;
+                }
+            } else if (c == '{' || c == '[') {
+                ++depth;
+            } else if ((c == '}' || c == ']') && --depth == 0) {
+                return i + 1;
+            }
+        }
+    }
+    nl = memchr(pobj->start, '\n', pobj->len);
+    return nl != NULL ? (size_t)(nl - pobj->start) + 1 : pobj->len;
+}
+
+/**
+ * \brief           Parse buffer of newline delimited or concatenated JSON documents
+ *
+ * Every document is parsed to the same array of tokens, and reported with callback function.
+ * Document ends right after closing bracket of its root object or array,
+ * next document may follow on the same or on any next line.
+ *
+ * Malformed document is reported with error result and skipped,
+ * parsing then continues with the next document.
+ *
+ * \note            Tokens are valid only during callback function
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in]       json_data: JSON documents to parse
+ * \param[in]       json_len: JSON data length
+ * \param[in]       evt_fn: Callback function, called once for every document
+ * \param[in]       user_data: User data passed to callback function
+ * \return          \ref lwjsonOK when all documents were parsed successfully,
+ *                      \ref lwjsonERR when at least one document is malformed,
+ *                      member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_parse_many(lwjson_t* lwobj, const void* json_data, size_t json_len, lwjson_parse_many_callback_fn evt_fn,
+                  void* user_data) {
+    lwjsonr_t res = lwjsonOK;
+    lwjson_int_str_t all = {.start = json_data, .len = json_len, .p = json_data};
+
+    if (lwobj == NULL || json_data == NULL || evt_fn == NULL) {
+        return lwjsonERRPAR;
+    }
+    prv_str_init(&all);
+    while (1) {
+        lwjsonr_t doc_res;
+        lwjson_int_str_t pobj;
+        uint8_t is_closed = 0;
+        size_t doc_len;
+
+        /* Skip blanks and line ends between documents */
+        doc_res = prv_skip_blank(&all);
+        if ((size_t)(all.p - all.start) == all.len) {
+            break;
+        }
+
+        /* Document is part of data from current position to the end */
+        pobj.start = all.p;
+        pobj.len = all.len - (size_t)(all.p - all.start);
+        pobj.readable = pobj.len;
+        pobj.p = all.p;
+#if LWJSON_CFG_STRUCT_INDEX
+        pobj.blk.pos = SIZE_MAX;
+#endif /* LWJSON_CFG_STRUCT_INDEX */
+#if LWJSON_CFG_INSITU
+        pobj.insitu = 0;
+#endif /* LWJSON_CFG_INSITU */
+
+        if (doc_res == lwjsonOK) {
+            doc_res = prv_parse_tokens(lwobj, &pobj, &is_closed, 0, NULL);
+        }
+        if (doc_res == lwjsonOK && is_closed) {
+            doc_len = (size_t)(pobj.p - pobj.start);
+            lwobj->flags.parsed = 1;
+        } else {
+            doc_res = doc_res == lwjsonOK ? lwjsonERRJSON : doc_res;
+            doc_len = prv_find_doc_end(&pobj);
+            lwobj->flags.parsed = 0;
+            res = lwjsonERR;
+        }
+        evt_fn(lwobj, doc_res, (size_t)(pobj.start - all.start), doc_len, user_data);
+        all.p = pobj.start + doc_len;
+    }
+    lwobj->flags.parsed = 0;
+    return res;
+}
+
+/**
+ * \brief           Split buffer of newline delimited JSON documents to chunks of whole lines
+ *
+ * Buffer is split to chunks of about the same size, each of them ending right after newline character,
+ * or at the end of data. Chunks can then be parsed in parallel with \ref lwjson_parse_many,
+ * each with its own LwJSON instance.
+ *
+ * Chunk `i` starts at offset `offsets[i - 1]` (or `0` for the first chunk) and ends before offset `offsets[i]`.
+ * Chunk is empty when the lines before it are longer than chunk size.
+ *
+ * \note            Documents must not span over multiple lines
+ * \param[in]       json_data: JSON documents to split
+ * \param[in]       json_len: JSON data length
+ * \param[out]      offsets: Array to write end offsets of the chunks to
+ * \param[in]       offsets_len: Number of chunks to split data to
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_split_many(const void* json_data, size_t json_len, size_t* offsets, size_t offsets_len) {
+    lwjson_int_str_t pobj = {.start = json_data, .len = json_len, .p = json_data};
+    size_t end = 0;
+
+    if (json_data == NULL || offsets == NULL || offsets_len == 0) {
+        return lwjsonERRPAR;
+    }
+    prv_str_init(&pobj);
+    for (size_t i = 0; i < offsets_len - 1; ++i) {
+        size_t pos = pobj.len / offsets_len * (i + 1) + pobj.len % offsets_len * (i + 1) / offsets_len;
+
+        /* Move chunk end after the next newline */
+        if (pos > end) {
+            const char* nl = memchr(&pobj.start[pos - 1], '\n', pobj.len - (pos - 1));
+            end = nl != NULL ? (size_t)(nl - pobj.start) + 1 : pobj.len;
+        }
+        offsets[i] = end;
+    }
+    offsets[offsets_len - 1] = pobj.len;
+    return lwjsonOK;
+}
+
+/**
+ * \brief           State of root array split
+ */
+typedef struct {
+    size_t* offsets;    /*!< End offsets of the chunks */
+    size_t offsets_len; /*!< Number of chunks */
+    size_t idx;         /*!< Index of next chunk end to find */
+    size_t depth;       /*!< Depth of nested objects and arrays */
+    uint64_t objects;   /*!< Bit `n` is set when level `n` is an object, for the first `64` levels */
+    size_t len;         /*!< Length of JSON data */
+    uint8_t is_closed;  /*!< Set to `1` when root array is closed with matching bracket */
+} lwjson_int_split_t;
+
+/**
+ * \brief           Process structural character for root array split
+ *
+ * Chunk ends at the first comma between elements of root array, after its nominal size.
+ * Remaining chunks end at closing bracket of the array.
+ *
+ * Closing bracket must match the opening one. Levels deeper than `64` are only counted,
+ * they are inside of chunks and checked when chunks are parsed.
+ *
+ * \param[in,out]   split: Split state
+ * \param[in]       c: Character outside of strings
+ * \param[in]       pos: Position of character in JSON data
+ * \return          `1` when scan is finished, at closing bracket of root array or at mismatched bracket,
+ *                      `0` otherwise
+ */
+static uint8_t
+prv_split_array_char(lwjson_int_split_t* split, char c, size_t pos) {
+    if (c == '{' || c == '[') {
+        if (split->depth < 64) {
+            split->objects = (split->objects & ~((uint64_t)1 << split->depth))
+                             | ((uint64_t)(c == '{') << split->depth);
+        }
+        ++split->depth;
+    } else if (c == '}' || c == ']') {
+        if (split->depth == 0) {
+            return 1;
+        }
+        --split->depth;
+        if (split->depth < 64 && ((split->objects >> split->depth) & 1) != (c == '}')) {
+            return 1;
+        }
+        if (split->depth == 0) {
+            for (; split->idx < split->offsets_len; ++split->idx) {
+                split->offsets[split->idx] = pos;
+            }
+            split->is_closed = 1;
+            return 1;
+        }
+    } else if (c == ',' && split->depth == 1) {
+        for (; split->idx < split->offsets_len - 1; ++split->idx) {
+            size_t n = split->idx + 1;
+            if (pos < split->len / split->offsets_len * n + split->len % split->offsets_len * n / split->offsets_len) {
+                break;
+            }
+            split->offsets[split->idx] = pos;
+        }
+    }
+    return 0;
+}
+
+#if LWJSON_CFG_STRUCT_INDEX && !LWJSON_CFG_COMMENTS
+
+/**
+ * \brief           Get number of set bits
+ * \param[in]       x: Value to check
+ * \return          Number of set bits
+ */
+static inline uint32_t
+prv_popcount64(uint64_t x) {
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint32_t)__builtin_popcountll(x);
+#else
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return (uint32_t)((x * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+/**
+ * \brief           String state carried over block boundary
+ */
+typedef struct {
+    uint64_t escaped;   /*!< First character of the block is escaped */
+    uint64_t in_string; /*!< All bits set when block starts inside of string */
+} lwjson_int_blk_str_t;
+
+/**
+ * \brief           Get mask of characters inside of strings, for the current block
+ *
+ * Quotes preceded by odd number of backslashes are part of string,
+ * and characters between quotes are found with prefix XOR of remaining quotes.
+ * Opening quote and string body are inside of string, closing quote is not.
+ *
+ * \param[in]       pobj: JSON string with classified block
+ * \param[in,out]   str: String state of previous block, set to all zeros for first block
+ * \param[out]      quote: Mask of quotes, that open or close strings
+ * \return          Mask of characters inside of strings
+ */
+static uint64_t
+prv_blk_string_mask(const lwjson_int_str_t* pobj, lwjson_int_blk_str_t* str, uint64_t* quote) {
+    const uint64_t even_bits = 0x5555555555555555ULL;
+    uint64_t bslash, follows, seq, escaped, in_string;
+
+    /* Characters preceded by odd number of backslashes */
+    bslash = pobj->blk.bslash & ~str->escaped;
+    follows = (bslash << 1) | str->escaped;
+    seq = (bslash & ~even_bits & ~follows) + bslash;
+    str->escaped = seq < bslash ? 1 : 0;
+    escaped = (even_bits ^ (seq << 1)) & follows;
+
+    *quote = pobj->blk.quote & ~escaped;
+    in_string = *quote ^ (*quote << 1);
+    in_string ^= in_string << 2;
+    in_string ^= in_string << 4;
+    in_string ^= in_string << 8;
+    in_string ^= in_string << 16;
+    in_string ^= in_string << 32;
+    in_string ^= str->in_string;
+    str->in_string = (uint64_t)0 - (in_string >> 63);
+    return in_string;
+}
+
+/**
+ * \brief           Count number of values in JSON data, using block bitmaps
+ *
+ * Every value is object or array, string that is not followed by colon, or number or literal.
+ *
+ * \param[in,out]   pobj: JSON string
+ * \return          Number of values, including root
+ */
+static size_t
+prv_count_values(lwjson_int_str_t* pobj) {
+    lwjson_int_blk_str_t str = {0, 0};
+    uint64_t prev_scalar = 0;
+    size_t quotes = 0, opens = 0, colons = 0, scalars = 0;
+
+    for (size_t pos = 0; pos < pobj->len; pos += LWJSON_BLK_SIZE) {
+        uint64_t quote, in_string, scalar, valid, op;
+
+        prv_blk_update(pobj, pos);
+        in_string = prv_blk_string_mask(pobj, &str, &quote);
+        quotes += prv_popcount64(quote);
+
+        /* Numbers and literals are runs of characters of no other class */
+        valid = pobj->len - pos < LWJSON_BLK_SIZE ? ((uint64_t)1 << (pobj->len - pos)) - 1 : UINT64_MAX;
+        scalar = ~(pobj->blk.blank | pobj->blk.op | pobj->blk.quote | in_string) & valid;
+        scalars += prv_popcount64(scalar & ~((scalar << 1) | prev_scalar));
+        prev_scalar = scalar >> 63;
+
+        /* Structural characters outside of strings */
+        for (op = pobj->blk.op & ~in_string; op != 0; op &= op - 1) {
+            char c = pobj->start[pos + prv_ctz64(op)];
+            if (c == '{' || c == '[') {
+                ++opens;
+            } else if (c == ':') {
+                ++colons;
+            }
+        }
+    }
+
+    /* Strings followed by colon are keys, their values are counted instead */
+    opens += (quotes + 1) / 2 + scalars;
+    return opens > colons ? opens - colons : 1;
+}
+
+/**
+ * \brief           Find commas to split root array at, using block bitmaps
+ * \param[in,out]   pobj: JSON string, with only blanks before root array
+ * \param[in,out]   split: Split state
+ * \return          `1` when root array is closed with matching bracket, `0` otherwise
+ */
+static uint8_t
+prv_split_array_scan(lwjson_int_str_t* pobj, lwjson_int_split_t* split) {
+    lwjson_int_blk_str_t str = {0, 0};
+
+    for (size_t pos = 0; pos < pobj->len; pos += LWJSON_BLK_SIZE) {
+        uint64_t quote, op;
+
+        prv_blk_update(pobj, pos);
+        for (op = pobj->blk.op & ~prv_blk_string_mask(pobj, &str, &quote); op != 0; op &= op - 1) {
+            size_t i = pos + prv_ctz64(op);
+            if (prv_split_array_char(split, pobj->start[i], i)) {
+                return split->is_closed;
+            }
+        }
+    }
+    return 0;
+}
+
+#else /* LWJSON_CFG_STRUCT_INDEX && !LWJSON_CFG_COMMENTS */
+
+/**
+ * \brief           Count number of values in JSON data
+ *
+ * Parser uses one token for every element of array and every key of object.
+ * Values after colon are part of the key token, only nested elements are counted for them
+ *
+ * \param[in,out]   pobj: JSON string
+ * \return          Number of values, including root
+ */
+static size_t
+prv_count_values(lwjson_int_str_t* pobj) {
+    size_t cnt = 1;       /* Root object or array always uses one token */
+    uint8_t is_value = 1; /* Next value belongs to already counted token (root or object key) */
+
+    while (prv_skip_blank(pobj) == lwjsonOK) {
+        switch (*pobj->p) {
+            case ':':
+                ++pobj->p;
+                is_value = 1;
+                continue;
+            case ',':
+            case '}':
+            case ']': ++pobj->p; break;
+            case '{':
+            case '[':
+                ++pobj->p;
+                cnt += is_value ? 0 : 1;
+                break;
+            case '"': {
+                const char* str;
+                size_t str_len;
+                uint8_t escaped;
+
+                cnt += is_value ? 0 : 1;
+                if (prv_parse_string(pobj, &str, &str_len, &escaped) != lwjsonOK) {
+                    return cnt;
+                }
+                break;
+            }
+            default:
+                /* Numbers and literals, end at the next blank or structural character */
+                cnt += is_value ? 0 : 1;
+                for (; (size_t)(pobj->p - pobj->start) < pobj->len; ++pobj->p) {
+                    if (*pobj->p == ' ' || *pobj->p == '\t' || *pobj->p == '\r' || *pobj->p == '\n'
+                        || *pobj->p == '\f' || *pobj->p == ',' || *pobj->p == ':' || *pobj->p == '"'
+                        || *pobj->p == '{' || *pobj->p == '}' || *pobj->p == '[' || *pobj->p == ']'
+                        || *pobj->p == '/') {
+                        break;
+                    }
+                }
+                if (!prv_str_is_end(pobj) && *pobj->p == '/') {
+                    /* Comment is handled by blank skip, or it is invalid character */
+                    if (prv_skip_blank(pobj) != lwjsonOK || *pobj->p == '/') {
+                        return cnt;
+                    }
+                }
+                break;
+        }
+        is_value = 0;
+    }
+    return cnt;
+}
+
+/**
+ * \brief           Find commas to split root array at
+ * \param[in,out]   pobj: JSON string, at opening bracket of root array
+ * \param[in,out]   split: Split state
+ * \return          `1` when root array is closed with matching bracket, `0` otherwise
+ */
+static uint8_t
+prv_split_array_scan(lwjson_int_str_t* pobj, lwjson_int_split_t* split) {
+    while (prv_skip_blank(pobj) == lwjsonOK && (size_t)(pobj->p - pobj->start) < pobj->len) {
+        if (*pobj->p == '"') {
+            const char* str;
+            size_t str_len;
+            uint8_t escaped;
+
+            if (prv_parse_string(pobj, &str, &str_len, &escaped) != lwjsonOK) {
+                return 0;
+            }
+            continue;
+        }
+        if (prv_split_array_char(split, *pobj->p, (size_t)(pobj->p - pobj->start))) {
+            return split->is_closed;
+        }
+        ++pobj->p;
+    }
+    return 0;
+}
+
+#endif /* !(LWJSON_CFG_STRUCT_INDEX && !LWJSON_CFG_COMMENTS) */
+
+/**
+ * \brief           Count number of tokens needed to parse JSON data
+ *
+ * Input is only scanned for structure, values are not converted.
+ * Returned value is the minimal `tokens_len` parameter for \ref lwjson_init,
+ * for \ref lwjson_parse_ex to parse the same data without \ref lwjsonERRMEM error.
+ *
+ * With \ref LWJSON_CFG_STRUCT_INDEX enabled, count is taken from block bitmaps,
+ * without visiting every value.
+ *
+ * \note            Count is exact for valid JSON data. Parsing invalid data with counted number of tokens
+ *                  may end with \ref lwjsonERRMEM instead of \ref lwjsonERRJSON error
+ * \param[in]       json_data: JSON data to scan
+ * \param[in]       json_len: JSON data length
+ * \return          Number of tokens
+ */
+size_t
+lwjson_count_tokens(const void* json_data, size_t json_len) {
+    lwjson_int_str_t pobj = {.start = json_data, .len = json_len, .p = json_data};
+    size_t cnt;
+
+    if (json_data == NULL || json_len == 0) {
+        return 0;
+    }
+    prv_str_init(&pobj);
+    cnt = prv_count_values(&pobj);
+#if LWJSON_CFG_COMPACT_TOKEN
+    return cnt;
+#else
+    return cnt - 1; /* Root is stored in LwJSON instance */
+#endif /* !LWJSON_CFG_COMPACT_TOKEN */
+}
+
+/**
+ * \brief           Split root array to chunks of whole elements, for parallel parsing
+ *
+ * Data is only scanned for structure, to find commas between elements of root array.
+ * Chunk `i` starts at offset `offsets[i - 1]` (or `0` for the first chunk) and ends before offset `offsets[i]`,
+ * at the comma before next chunk, or at closing bracket of the array.
+ * Chunk is empty when the elements before it are larger than chunk size.
+ *
+ * Chunks are parsed with \ref lwjson_parse_array_part and joined with \ref lwjson_join_array.
+ *
+ * \param[in]       json_data: JSON data with array as root
+ * \param[in]       json_len: JSON data length
+ * \param[out]      offsets: Array to write end offsets of the chunks to
+ * \param[in]       offsets_len: Number of chunks to split array to
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_split_array(const void* json_data, size_t json_len, size_t* offsets, size_t offsets_len) {
+    lwjson_int_str_t pobj = {.start = json_data, .len = json_len, .p = json_data};
+    lwjson_int_split_t split = {.offsets = offsets, .offsets_len = offsets_len};
+
+    if (json_data == NULL || offsets == NULL || offsets_len == 0) {
+        return lwjsonERRPAR;
+    }
+    prv_str_init(&pobj);
+    split.len = pobj.len;
+    if (prv_skip_blank(&pobj) != lwjsonOK || (size_t)(pobj.p - pobj.start) == pobj.len || *pobj.p != '['
+        || !prv_split_array_scan(&pobj, &split)) {
+        return lwjsonERRJSON;
+    }
+
+    /* Only blanks may follow closing bracket */
+    pobj.p = &pobj.start[offsets[offsets_len - 1] + 1];
+    prv_skip_blank(&pobj);
+    return (size_t)(pobj.p - pobj.start) == pobj.len ? lwjsonOK : lwjsonERRJSON;
+}
+
+#if !LWJSON_CFG_COMPACT_TOKEN
+
+/**
+ * \brief           Parse chunk of root array, as split with \ref lwjson_split_array
+ *
+ * Elements of the chunk are parsed as children of root array token.
+ * Chunks may be parsed in parallel, each of them with its own LwJSON instance.
+ *
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in]       json_data: Chunk data, pointing to the original JSON data
+ * \param[in]       json_len: Chunk data length
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_parse_array_part(lwjson_t* lwobj, const void* json_data, size_t json_len) {
+    lwjsonr_t res;
+    uint8_t is_closed;
+    lwjson_int_str_t pobj = {.start = json_data, .len = json_len, .p = json_data};
+
+    if (lwobj == NULL || json_data == NULL) {
+        return lwjsonERRPAR;
+    }
+
+    /* Empty chunk has no elements */
+    if (json_len == 0) {
+        lwjson_reset(lwobj);
+        LWJSON_MEMSET(&lwobj->first_token, 0x00, sizeof(lwobj->first_token));
+        lwobj->first_token.type = LWJSON_TYPE_ARRAY;
+        lwobj->flags.parsed = 1;
+        return lwjsonOK;
+    }
+    prv_str_init(&pobj);
+    res = prv_parse_tokens(lwobj, &pobj, &is_closed, 1, NULL);
+
+    /* Root array is closed only after the last chunk */
+    if (res == lwjsonOK && is_closed) {
+        res = lwjsonERRJSON;
+    }
+    if (res == lwjsonOK) {
+        lwobj->flags.parsed = 1;
+    }
+    return res;
+}
+
+/**
+ * \brief           Join parsed chunks of root array to single tree
+ *
+ * Elements of all chunks are linked, in order of chunks, as children of root array token of `lwobj` instance,
+ * that can then be used with \ref lwjson_find and other functions.
+ * Last element of every chunk is known from \ref lwjson_parse_array_part, chunks are linked in constant time.
+ *
+ * \note            Tokens of chunks must stay valid while `lwobj` is used,
+ *                  and instances of chunks shall not be used anymore on their own
+ * \param[in,out]   lwobj: LwJSON instance, different from instances of chunks
+ * \param[in,out]   parts: Array of instances, parsed with \ref lwjson_parse_array_part
+ * \param[in]       parts_cnt: Number of instances in `parts` array
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_join_array(lwjson_t* lwobj, lwjson_t* parts, size_t parts_cnt) {
+    lwjson_token_t *root, *last = NULL;
+    uint8_t has_elements = 0;
+
+    if (lwobj == NULL || parts == NULL) {
+        return lwjsonERRPAR;
+    }
+    for (size_t i = 0; i < parts_cnt; ++i) {
+        if (&parts[i] == lwobj || !parts[i].flags.parsed || parts[i].first_token.type != LWJSON_TYPE_ARRAY) {
+            return lwjsonERRPAR;
+        }
+        /* Comma must follow an element of previous chunks, not opening bracket of the array */
+        if (parts[i].flags.part_sep && !has_elements) {
+            return lwjsonERRJSON;
+        }
+        has_elements |= parts[i].first_token.u.first_child != NULL;
+    }
+    lwjson_reset(lwobj);
+    root = &lwobj->first_token;
+    LWJSON_MEMSET(root, 0x00, sizeof(*root));
+    root->type = LWJSON_TYPE_ARRAY;
+    for (size_t i = 0; i < parts_cnt; ++i) {
+        lwjson_token_t* first = parts[i].first_token.u.first_child;
+
+        lwobj->next_free_token_pos += parts[i].next_free_token_pos;
+        parts[i].flags.parsed = 0;
+        if (first == NULL) {
+            continue;
+        }
+        if (last == NULL) {
+            root->u.first_child = first;
+        } else {
+            last->next = first;
+        }
+        last = parts[i].last_child;
+#if LWJSON_CFG_CHILD_INDEX
+        root->child_cnt += parts[i].first_token.child_cnt;
+#endif /* LWJSON_CFG_CHILD_INDEX */
+    }
+#if LWJSON_CFG_CHILD_INDEX
+    prv_build_child_index(lwobj, root);
+#endif /* LWJSON_CFG_CHILD_INDEX */
+    lwobj->flags.parsed = 1;
+    return lwjsonOK;
+}
+
+#endif /* !LWJSON_CFG_COMPACT_TOKEN */
+
+/**
+ * \brief           Reset instance for parsing of next JSON data
+ *
+ * Tokens of previous parse operation are dropped in constant time.
+ * Array of tokens is not cleared, tokens are initialized again when they are used by the parser.
+ * Allocated blocks of the arena and index buffer are kept for reuse.
+ *
+ * \param[in,out]   lwobj: LwJSON instance
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_reset(lwjson_t* lwobj) {
+    if (lwobj == NULL) {
+        return lwjsonERRPAR;
+    }
+    lwobj->next_free_token_pos = 0;
+#if LWJSON_CFG_ARENA
+    lwobj->arena_cur = NULL;
+    lwobj->arena_pos = 0;
+#endif /* LWJSON_CFG_ARENA */
+#if LWJSON_CFG_CHILD_INDEX
+    lwobj->next_free_index_pos = 0;
+#endif /* LWJSON_CFG_CHILD_INDEX */
+#if LWJSON_CFG_KEY_INDEX
+    lwobj->next_free_key_index_pos = 0;
+#endif /* LWJSON_CFG_KEY_INDEX */
+#if !LWJSON_CFG_COMPACT_TOKEN
+    lwobj->last_child = NULL;
+#endif /* !LWJSON_CFG_COMPACT_TOKEN */
+    lwobj->flags.parsed = 0;
+    lwobj->flags.part_sep = 0;
+    return lwjsonOK;
+}
+
+/**
+ * \brief           Free token instances (specially used in case of dynamic memory allocation)
+ * \note            Tokens are dropped in constant time, same as with \ref lwjson_reset.
+ *                  File mapped by \ref lwjson_parse_file is unmapped
+ * \param[in,out]   lwobj: LwJSON instance
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_free(lwjson_t* lwobj) {
+#if LWJSON_CFG_FILE
+    if (lwobj != NULL && lwobj->file_data != NULL) {
+        lwjson_file_unmap(lwobj->file_data, lwobj->file_len);
+        lwobj->file_data = NULL;
+        lwobj->file_len = 0;
+    }
+#endif /* LWJSON_CFG_FILE */
+    return lwjson_reset(lwobj);
+}
+
+#if LWJSON_CFG_ARENA
+
+/**
+ * \brief           Release all blocks of tokens allocated by the arena
+ * \note            Tokens of the last parse operation are no longer valid.
+ *                  Instance can be used for parsing again, blocks are allocated when needed
+ * \param[in,out]   lwobj: LwJSON instance
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_arena_release(lwjson_t* lwobj) {
+    lwjson_arena_blk_t* blk;
+
+    if (lwobj == NULL) {
+        return lwjsonERRPAR;
+    }
+    for (blk = lwobj->arena_first; blk != NULL;) {
+        lwjson_token_t* tokens = blk->tokens;
+
+        blk = blk->next;
+        LWJSON_FREE(tokens);
+    }
+    lwobj->arena_first = NULL;
+    lwobj->arena_len = lwobj->tokens_len;
+    return lwjson_reset(lwobj);
+}
+
+#endif /* LWJSON_CFG_ARENA */
+
+/**
+ * \brief           Find first match in the given path for JSON entry
+ * JSON must be valid and parsed with \ref lwjson_parse function
+ * \param[in]       lwobj: JSON instance with parsed JSON string
+ * \param[in]       path: Path with dot-separated entries to search for the JSON key to return
+ * \return          Pointer to found token on success, `NULL` if token cannot be found
+ */
+const lwjson_token_t*
+lwjson_find(lwjson_t* lwobj, const char* path) {
+    if (lwobj == NULL || !lwobj->flags.parsed || path == NULL) {
+        return NULL;
+    }
+    return prv_find(lwobj, lwjson_get_first_token(lwobj), path);
+}
+
+/**
+ * \brief           Find first match in the given path for JSON path
+ * JSON must be valid and parsed with \ref lwjson_parse function
+ *
+ * \param[in]       lwobj: JSON instance with parsed JSON string
+ * \param[in]       token: Root token to start search at.
+ *                      Token must be type \ref LWJSON_TYPE_OBJECT or \ref LWJSON_TYPE_ARRAY.
+ *                      Set to `NULL` to use root token of LwJSON object
+ * \param[in]       path: path with dot-separated entries to search for JSON key
+ * \return          Pointer to found token on success, `NULL` if token cannot be found
+ */
+const lwjson_token_t*
+lwjson_find_ex(lwjson_t* lwobj, const lwjson_token_t* token, const char* path) {
+    if (lwobj == NULL || !lwobj->flags.parsed || path == NULL) {
+        return NULL;
+    }
+    if (token == NULL) {
+        token = lwjson_get_first_token(lwobj);
+    }
+    if (token == NULL || (token->type != LWJSON_TYPE_ARRAY && token->type != LWJSON_TYPE_OBJECT)) {
+        return NULL;
+    }
+    return prv_find(lwobj, token, path);
+}
+
+/**
+ * \brief           Compile path for repeated search with \ref lwjson_find_compiled
+ *
+ * Path is split to segments, lengths of keys and array indexes are calculated only once,
+ * and search with compiled path gives the same result as \ref lwjson_find_ex with the original path.
+ *
+ * \note            Key names point to the path string, that must stay valid while compiled path is used
+ * \param[in]       path: Path with dot-separated entries to search for JSON key
+ * \param[out]      compiled: Compiled path
+ * \return          \ref lwjsonOK on success, \ref lwjsonERRPAR if path is invalid,
+ *                  \ref lwjsonERRMEM if it has more than \ref LWJSON_CFG_PATH_MAX_SEGMENTS segments
+ */
+lwjsonr_t
+lwjson_path_compile(const char* path, lwjson_path_t* compiled) {
+    uint8_t is_last = 0;
+
+    if (path == NULL || compiled == NULL) {
+        return lwjsonERRPAR;
+    }
+    LWJSON_MEMSET(compiled, 0x00, sizeof(*compiled));
+    while (!is_last) {
+        lwjson_path_segment_t* seg;
+
+        if (compiled->segments_cnt >= LWJSON_ARRAYSIZE(compiled->segments)) {
+            return lwjsonERRMEM;
+        }
+        seg = &compiled->segments[compiled->segments_cnt++];
+
+        /* Any element must be followed by more segments */
+        if (!prv_path_segment(&path, seg, &is_last) || (seg->type == LWJSON_PATH_ANY && is_last)) {
+            return lwjsonERRPAR;
+        }
+    }
+    return lwjsonOK;
+}
+
+/**
+ * \brief           Input recursive function for find operation with compiled path
+ * \param[in]       lwobj: LwJSON instance
+ * \param[in]       parent: Parent token of type \ref LWJSON_TYPE_ARRAY or LWJSON_TYPE_OBJECT
+ * \param[in]       seg: Segment to search for in the parent
+ * \param[in]       seg_cnt: Number of segments, including `seg`
+ * \return          Found token on success, `NULL` otherwise
+ */
+static const lwjson_token_t*
+prv_find_compiled(const lwjson_t* lwobj, const lwjson_token_t* parent, const lwjson_path_segment_t* seg,
+                  size_t seg_cnt) {
+    const lwjson_token_t *tkn, *tmp;
+
+    if (seg->type == LWJSON_PATH_KEY) {
+        if (parent->type != LWJSON_TYPE_OBJECT) {
+            return NULL;
+        }
+        for (tkn = prv_find_key_child(lwobj, parent, seg->name, seg->name_len, seg->hash, NULL); tkn != NULL;
+             tkn = prv_find_key_child(lwobj, parent, seg->name, seg->name_len, seg->hash, tkn)) {
+            tmp = seg_cnt == 1 ? tkn : prv_find_compiled(lwobj, tkn, seg + 1, seg_cnt - 1);
+            if (tmp != NULL) {
+                return tmp;
+            }
+        }
+        return NULL;
+    }
+
+    /* Array segments */
+    if (parent->type != LWJSON_TYPE_ARRAY) {
+        return NULL;
+    }
+    if (seg->type == LWJSON_PATH_INDEX) {
+        tkn = prv_get_child_at(parent, seg->index);
+        if (tkn == NULL || seg_cnt == 1) {
+            return tkn;
+        }
+        return prv_find_compiled(lwobj, tkn, seg + 1, seg_cnt - 1);
+    }
+
+    /* Scan all indexes and get first match */
+    for (tkn = lwjson_get_first_child(parent); tkn != NULL; tkn = lwjson_get_next(tkn)) {
+        tmp = prv_find_compiled(lwobj, tkn, seg + 1, seg_cnt - 1);
+        if (tmp != NULL) {
+            return tmp;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * \brief           Find first match for compiled path
+ * JSON must be valid and parsed with \ref lwjson_parse function
+ *
+ * \param[in]       lwobj: JSON instance with parsed JSON string
+ * \param[in]       token: Root token to start search at.
+ *                      Token must be type \ref LWJSON_TYPE_OBJECT or \ref LWJSON_TYPE_ARRAY.
+ *                      Set to `NULL` to use root token of LwJSON object
+ * \param[in]       compiled: Path compiled with \ref lwjson_path_compile
+ * \return          Pointer to found token on success, `NULL` if token cannot be found
+ */
+const lwjson_token_t*
+lwjson_find_compiled(lwjson_t* lwobj, const lwjson_token_t* token, const lwjson_path_t* compiled) {
+    if (lwobj == NULL || !lwobj->flags.parsed || compiled == NULL || compiled->segments_cnt == 0) {
+        return NULL;
+    }
+    if (token == NULL) {
+        token = lwjson_get_first_token(lwobj);
+    }
+    if (token == NULL || (token->type != LWJSON_TYPE_ARRAY && token->type != LWJSON_TYPE_OBJECT)) {
+        return NULL;
+    }
+    return prv_find_compiled(lwobj, token, compiled->segments, compiled->segments_cnt);
+}
+
+/**
+ * \brief           Context of find operation with multiple paths
+ */
+typedef struct {
+    const lwjson_t* lwobj;          /*!< LwJSON instance */
+    const lwjson_path_t* paths;     /*!< Array of compiled paths */
+    const lwjson_token_t** results; /*!< Array of found tokens */
+    uint64_t pending;               /*!< Bit mask of paths not found yet */
+} lwjson_int_find_many_t;
+
+static void prv_find_many(lwjson_int_find_many_t* fm, const lwjson_token_t* parent, uint64_t mask, size_t depth);
+
+/**
+ * \brief           Check if two path segments are the same
+ * \param[in]       a: First segment
+ * \param[in]       b: Second segment
+ * \return          `1` if segments are the same, `0` otherwise
+ */
+static inline uint8_t
+prv_segment_equal(const lwjson_path_segment_t* a, const lwjson_path_segment_t* b) {
+    if (a->type != b->type) {
+        return 0;
+    }
+    if (a->type == LWJSON_PATH_KEY) {
+        return a->hash == b->hash && a->name_len == b->name_len && !strncmp(a->name, b->name, a->name_len);
+    }
+    return a->type == LWJSON_PATH_ANY || a->index == b->index;
+}
+
+/**
+ * \brief           Process child token, that matches segment of group of paths
+ *
+ * Paths ending with the segment are resolved to the child,
+ * all others continue the search in the child together.
+ *
+ * \param[in,out]   fm: Find context
+ * \param[in]       tkn: Child token that matches the segment
+ * \param[in]       group: Bit mask of paths with the same segment at `depth`
+ * \param[in]       depth: Segment index, matched by the child
+ */
+static void
+prv_find_many_child(lwjson_int_find_many_t* fm, const lwjson_token_t* tkn, uint64_t group, size_t depth) {
+    uint64_t sub = 0;
+
+    for (uint64_t m = group & fm->pending; m != 0; m &= m - 1) {
+        uint32_t i = prv_ctz64(m);
+
+        if (depth + 1 == fm->paths[i].segments_cnt) {
+            fm->results[i] = tkn;
+            fm->pending &= ~((uint64_t)1 << i);
+        } else {
+            sub |= (uint64_t)1 << i;
+        }
+    }
+    if (sub != 0 && (tkn->type == LWJSON_TYPE_OBJECT || tkn->type == LWJSON_TYPE_ARRAY)) {
+        prv_find_many(fm, tkn, sub, depth + 1);
+    }
+}
+
+/**
+ * \brief           Input recursive function for find operation with multiple paths
+ *
+ * Paths with the same segment at `depth` are searched together, as a group,
+ * hence common beginning of the paths is walked only once.
+ * Every path is resolved to the first child, in order of the parent, that matches the rest of the path,
+ * which is the same token as returned by \ref lwjson_find_compiled.
+ *
+ * \param[in,out]   fm: Find context
+ * \param[in]       parent: Parent token of type \ref LWJSON_TYPE_ARRAY or LWJSON_TYPE_OBJECT
+ * \param[in]       mask: Bit mask of paths to search for in the parent
+ * \param[in]       depth: Segment index of the paths to match with children of the parent
+ */
+static void
+prv_find_many(lwjson_int_find_many_t* fm, const lwjson_token_t* parent, uint64_t mask, size_t depth) {
+    const lwjson_token_t* tkn;
+    uint64_t todo = mask & fm->pending;
+
+    while (todo != 0) {
+        const lwjson_path_segment_t* seg = &fm->paths[prv_ctz64(todo)].segments[depth];
+        uint64_t group = todo & (~todo + 1);
+
+        /* Group ends at first path with different segment, paths listed in order share the most */
+        for (uint64_t m = todo & ~group; m != 0; m &= m - 1) {
+            uint32_t j = prv_ctz64(m);
+
+            if (!prv_segment_equal(seg, &fm->paths[j].segments[depth])) {
+                break;
+            }
+            group |= (uint64_t)1 << j;
+        }
+        todo &= ~group;
+
+        if (seg->type == LWJSON_PATH_KEY) {
+            if (parent->type != LWJSON_TYPE_OBJECT) {
+                continue;
+            }
+            for (tkn = prv_find_key_child(fm->lwobj, parent, seg->name, seg->name_len, seg->hash, NULL);
+                 tkn != NULL && (group & fm->pending);
+                 tkn = prv_find_key_child(fm->lwobj, parent, seg->name, seg->name_len, seg->hash, tkn)) {
+                prv_find_many_child(fm, tkn, group, depth);
+            }
+        } else if (parent->type == LWJSON_TYPE_ARRAY) {
+            if (seg->type == LWJSON_PATH_INDEX) {
+                if ((tkn = prv_get_child_at(parent, seg->index)) != NULL) {
+                    prv_find_many_child(fm, tkn, group, depth);
+                }
+                continue;
+            }
+            for (tkn = lwjson_get_first_child(parent); tkn != NULL && (group & fm->pending);
+                 tkn = lwjson_get_next(tkn)) {
+                prv_find_many_child(fm, tkn, group, depth);
+            }
+        }
+    }
+}
+
+/**
+ * \brief           Find tokens for multiple compiled paths in single walk of the tree
+ *
+ * Paths with common beginning share the walk, and are separated only where their segments differ.
+ * Every result is the same token as returned by \ref lwjson_find_compiled for the path.
+ *
+ * \param[in]       lwobj: JSON instance with parsed JSON string
+ * \param[in]       paths: Array of paths compiled with \ref lwjson_path_compile
+ * \param[in]       paths_cnt: Number of paths, up to `64`
+ * \param[out]      results: Array of `paths_cnt` entries to write found tokens to, `NULL` for paths not found
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_find_many(lwjson_t* lwobj, const lwjson_path_t* paths, size_t paths_cnt, const lwjson_token_t** results) {
+    lwjson_int_find_many_t fm = {.lwobj = lwobj, .paths = paths, .results = results};
+
+    if (lwobj == NULL || paths == NULL || results == NULL || paths_cnt > 64) {
+        return lwjsonERRPAR;
+    }
+    for (size_t i = 0; i < paths_cnt; ++i) {
+        results[i] = NULL;
+        if (paths[i].segments_cnt > 0) {
+            fm.pending |= (uint64_t)1 << i;
+        }
+    }
+    if (!lwobj->flags.parsed) {
+        return lwjsonERRPAR;
+    }
+    if (fm.pending != 0) {
+        prv_find_many(&fm, lwjson_get_first_token(lwobj), fm.pending, 0);
+    }
+    return lwjsonOK;
+}
+
+/**
+ * \brief           Check if key name matches reference token of JSON pointer
+ *
+ * Reference token is compared with `~0` decoded as `~` and `~1` decoded as `/`.
+ *
+ * \param[in]       name: Key name
+ * \param[in]       name_len: Length of key name
+ * \param[in]       ref: Reference token
+ * \param[in]       ref_len: Length of reference token
+ * \return          `1` if name matches reference token, `0` otherwise
+ */
+static uint8_t
+prv_pointer_name_equal(const char* name, size_t name_len, const char* ref, size_t ref_len) {
+    size_t i = 0;
+
+    for (size_t r = 0; r < ref_len; ++r, ++i) {
+        char ch = ref[r];
+
+        if (ch == '~') {
+            if (++r == ref_len || (ref[r] != '0' && ref[r] != '1')) {
+                return 0;
+            }
+            ch = ref[r] == '0' ? '~' : '/';
+        }
+        if (i >= name_len || name[i] != ch) {
+            return 0;
+        }
+    }
+    return i == name_len;
+}
+
+/**
+ * \brief           Find token with JSON pointer, as defined by RFC 6901
+ *
+ * Pointer is a sequence of reference tokens, each prefixed by `/` character, such as `/cars/0/brand`.
+ * Empty pointer refers to the root token. Characters `~` and `/` in key names are written as `~0` and `~1`.
+ *
+ * \note            Key names are compared with raw JSON data, escape sequences in the names are not decoded
+ * \param[in]       lwobj: JSON instance with parsed JSON string
+ * \param[in]       token: Root token to start search at.
+ *                      Set to `NULL` to use root token of LwJSON object
+ * \param[in]       pointer: JSON pointer
+ * \return          Pointer to found token on success, `NULL` if token cannot be found
+ */
+const lwjson_token_t*
+lwjson_find_pointer(lwjson_t* lwobj, const lwjson_token_t* token, const char* pointer) {
+    if (lwobj == NULL || !lwobj->flags.parsed || pointer == NULL) {
+        return NULL;
+    }
+    if (token == NULL) {
+        token = lwjson_get_first_token(lwobj);
+    }
+    while (token != NULL && *pointer != '\0') {
+        const char* ref;
+        size_t ref_len;
+
+        if (*pointer != '/') {
+            return NULL;
+        }
+        ref = ++pointer;
+        for (; *pointer != '\0' && *pointer != '/'; ++pointer) {}
+        ref_len = (size_t)(pointer - ref);
+
+        if (token->type == LWJSON_TYPE_OBJECT) {
+            const lwjson_token_t* tkn;
+
+            for (tkn = lwjson_get_first_child(token); tkn != NULL; tkn = lwjson_get_next(tkn)) {
+                if (prv_pointer_name_equal(lwjson_get_name(lwobj, tkn, NULL), tkn->token_name_len, ref, ref_len)) {
+                    break;
+                }
+            }
+            token = tkn;
+        } else if (token->type == LWJSON_TYPE_ARRAY) {
+            size_t index = 0;
+
+            /* Index is decimal number without leading zeros, `-` refers to element after the last one */
+            if (ref_len == 0 || (ref_len > 1 && ref[0] == '0')) {
+                return NULL;
+            }
+            for (size_t i = 0; i < ref_len; ++i) {
+                /* Index out of range of `size_t` cannot refer to any element */
+                if (ref[i] < '0' || ref[i] > '9' || index > (SIZE_MAX - (size_t)(ref[i] - '0')) / 10) {
+                    return NULL;
+                }
+                index = index * 10 + (ref[i] - '0');
+            }
+            token = prv_get_child_at(token, index);
+        } else {
+            return NULL;
+        }
+    }
+    return token;
+}
+
+#if LWJSON_CFG_QUERY
+
+/**
+ * \brief           Parse signed decimal integer of the query
+ * \param[in,out]   query: Pointer to query string, advanced after the number on success
+ * \param[out]      val: Parsed value
+ * \return          `1` on success, `0` if there is no number or it is out of range
+ */
+static uint8_t
+prv_query_parse_int(const char** query, int32_t* val) {
+    const char* q = *query;
+    uint8_t is_neg = 0;
+    int32_t num = 0;
+
+    if (*q == '-') {
+        is_neg = 1;
+        ++q;
+    }
+    if (*q < '0' || *q > '9') {
+        return 0;
+    }
+    for (; *q >= '0' && *q <= '9'; ++q) {
+        if (num > (INT32_MAX - (*q - '0')) / 10) {
+            return 0;
+        }
+        num = num * 10 + (*q - '0');
+    }
+    *val = is_neg ? -num : num;
+    *query = q;
+    return 1;
+}
+
+/**
+ * \brief           Parse bracket segment of the query
+ *
+ * Supported are `[*]`, `['name']`, `["name"]`, `[N]` and `[start:end:step]` segments.
+ *
+ * \param[in,out]   query: Pointer to query string at `[` character, advanced after `]` on success
+ * \param[out]      seg: Segment to fill
+ * \return          `1` on success, `0` otherwise
+ */
+static uint8_t
+prv_query_parse_bracket(const char** query, lwjson_query_segment_t* seg) {
+    const char* q = *query + 1;
+
+    if (*q == '*') {
+        seg->type = LWJSON_QUERY_WILDCARD;
+        ++q;
+    } else if (*q == '\'' || *q == '"') {
+        char quote = *q++;
+
+        seg->name = q;
+        for (; *q != '\0' && *q != quote; ++q) {}
+        if (*q != quote) {
+            return 0;
+        }
+        seg->name_len = (size_t)(q - seg->name);
+        seg->type = LWJSON_QUERY_KEY;
+        ++q;
+    } else {
+        uint8_t has_start = prv_query_parse_int(&q, &seg->start);
+
+        if (*q == ':') {
+            ++q;
+            seg->type = LWJSON_QUERY_SLICE;
+            seg->end = INT32_MAX;
+            seg->step = 1;
+            prv_query_parse_int(&q, &seg->end);
+            if (*q == ':') {
+                ++q;
+                if (prv_query_parse_int(&q, &seg->step) && seg->step <= 0) {
+                    return 0;
+                }
+            }
+        } else if (has_start) {
+            seg->type = LWJSON_QUERY_INDEX;
+        } else {
+            return 0;
+        }
+    }
+    if (*q != ']') {
+        return 0;
+    }
+    *query = q + 1;
+    return 1;
+}
+
+/**
+ * \brief           Compile query for \ref lwjson_query
+ *
+ * Query starts with `$`, referring to the root token, followed by segments:
+ *
+ *  - `.name` or `['name']` for object member
+ *  - `[N]` for array element, negative index counts from the end of array
+ *  - `[start:end:step]` for array elements in range, with the same rules as Python slices and positive step
+ *  - `.*` or `[*]` for any object member or array element
+ *  - `..` prefix of any segment to match it at any depth, such as `$..name` or `$..[0]`
+ *
+ * \note            Key names point to the query string, that must stay valid while compiled query is used
+ * \param[in]       query: Query string
+ * \param[out]      compiled: Compiled query
+ * \return          \ref lwjsonOK on success, \ref lwjsonERRPAR if query is invalid,
+ *                  \ref lwjsonERRMEM if it has more than \ref LWJSON_CFG_PATH_MAX_SEGMENTS segments
+ */
+lwjsonr_t
+lwjson_query_compile(const char* query, lwjson_query_t* compiled) {
+    if (query == NULL || compiled == NULL) {
+        return lwjsonERRPAR;
+    }
+    LWJSON_MEMSET(compiled, 0x00, sizeof(*compiled));
+    if (*query++ != '$') {
+        return lwjsonERRPAR;
+    }
+    while (*query != '\0') {
+        lwjson_query_segment_t* seg;
+
+        if (compiled->segments_cnt >= LWJSON_ARRAYSIZE(compiled->segments)) {
+            return lwjsonERRMEM;
+        }
+        seg = &compiled->segments[compiled->segments_cnt++];
+        if (*query == '[') {
+            if (!prv_query_parse_bracket(&query, seg)) {
+                return lwjsonERRPAR;
+            }
+            continue;
+        }
+        if (*query++ != '.') {
+            return lwjsonERRPAR;
+        }
+        if (*query == '.') {
+            seg->descendant = 1;
+            ++query;
+            if (*query == '[') {
+                if (!prv_query_parse_bracket(&query, seg)) {
+                    return lwjsonERRPAR;
+                }
+                continue;
+            }
+        }
+        if (*query == '*') {
+            seg->type = LWJSON_QUERY_WILDCARD;
+            ++query;
+        } else {
+            seg->type = LWJSON_QUERY_KEY;
+            seg->name = query;
+            for (; *query != '\0' && *query != '.' && *query != '['; ++query) {}
+            seg->name_len = (size_t)(query - seg->name);
+            if (seg->name_len == 0) {
+                return lwjsonERRPAR;
+            }
+        }
+    }
+    return lwjsonOK;
+}
+
+/**
+ * \brief           Context of query operation
+ */
+typedef struct {
+    lwjson_t* lwobj;                 /*!< LwJSON instance */
+    const lwjson_query_t* query;     /*!< Compiled query */
+    lwjson_query_callback_fn evt_fn; /*!< Callback function for matched tokens */
+    void* user_data;                 /*!< User data for callback function */
+} lwjson_int_query_t;
+
+static void prv_query(lwjson_int_query_t* qc, const lwjson_token_t* parent, uint64_t states);
+
+/**
+ * \brief           Convert index of the query to position in array
+ * \param[in]       index: Index, negative value counts from the end of array
+ * \param[in]       cnt: Number of elements in array
+ * \return          Position in array, `0` for negative index before the beginning
+ */
+static size_t
+prv_query_array_pos(int32_t index, size_t cnt) {
+    if (index >= 0) {
+        return (size_t)index;
+    }
+    return (size_t)-(int64_t)index > cnt ? 0 : cnt - (size_t)-(int64_t)index;
+}
+
+/**
+ * \brief           Check if child token matches segment of the query
+ * \param[in]       lwobj: LwJSON instance
+ * \param[in]       seg: Query segment
+ * \param[in]       parent: Parent token of the child
+ * \param[in]       tkn: Child token
+ * \param[in]       pos: Position of the child in the parent
+ * \param[in]       cnt: Number of children in array parent, used for negative indexes only
+ * \return          `1` if child matches the segment, `0` otherwise
+ */
+static uint8_t
+prv_query_match(const lwjson_t* lwobj, const lwjson_query_segment_t* seg, const lwjson_token_t* parent,
+                const lwjson_token_t* tkn, size_t pos, size_t cnt) {
+    switch (seg->type) {
+        case LWJSON_QUERY_WILDCARD: return 1;
+        case LWJSON_QUERY_KEY:
+            return parent->type == LWJSON_TYPE_OBJECT && tkn->token_name_len == seg->name_len
+                   && !strncmp(lwjson_get_name(lwobj, tkn, NULL), seg->name, seg->name_len);
+        case LWJSON_QUERY_INDEX:
+            if (parent->type != LWJSON_TYPE_ARRAY || (seg->start < 0 && (size_t)-(int64_t)seg->start > cnt)) {
+                return 0;
+            }
+            return pos == prv_query_array_pos(seg->start, cnt);
+        case LWJSON_QUERY_SLICE: {
+            size_t start = prv_query_array_pos(seg->start, cnt);
+
+            return parent->type == LWJSON_TYPE_ARRAY && pos >= start && pos < prv_query_array_pos(seg->end, cnt)
+                   && (pos - start) % (size_t)seg->step == 0;
+        }
+        default: return 0;
+    }
+}
+
+/**
+ * \brief           Process child token with the states matched by it
+ *
+ * Child is reported when it matches the last segment of the query,
+ * and search continues in the child for all other states.
+ *
+ * \param[in]       qc: Query context
+ * \param[in]       tkn: Child token
+ * \param[in]       states: Bit mask of query segments to match in children of the token
+ */
+static void
+prv_query_child(lwjson_int_query_t* qc, const lwjson_token_t* tkn, uint64_t states) {
+    uint64_t done = (uint64_t)1 << qc->query->segments_cnt;
+
+    if (states & done) {
+        qc->evt_fn(qc->lwobj, tkn, qc->user_data);
+        states &= ~done;
+    }
+    if (states != 0 && (tkn->type == LWJSON_TYPE_OBJECT || tkn->type == LWJSON_TYPE_ARRAY)) {
+        prv_query(qc, tkn, states);
+    }
+}
+
+/**
+ * \brief           Input recursive function for query operation
+ *
+ * Every bit of `states` is an index of the query segment to match next,
+ * hence all branches of wildcards and recursive descents are followed together,
+ * every token is visited at most once and matches are reported in document order.
+ *
+ * \param[in]       qc: Query context
+ * \param[in]       parent: Parent token of type \ref LWJSON_TYPE_ARRAY or LWJSON_TYPE_OBJECT
+ * \param[in]       states: Bit mask of query segments to match in children of the parent
+ */
+static void
+prv_query(lwjson_int_query_t* qc, const lwjson_token_t* parent, uint64_t states) {
+    const lwjson_token_t* tkn;
+    size_t pos = 0, cnt = 0;
+
+    /* Single key or index segment is resolved without comparing all children */
+    if ((states & (states - 1)) == 0) {
+        const lwjson_query_segment_t* seg = &qc->query->segments[prv_ctz64(states)];
+
+        if (!seg->descendant && seg->type == LWJSON_QUERY_KEY) {
+            uint32_t hash = prv_key_hash(seg->name, seg->name_len);
+
+            if (parent->type != LWJSON_TYPE_OBJECT) {
+                return;
+            }
+            for (tkn = prv_find_key_child(qc->lwobj, parent, seg->name, seg->name_len, hash, NULL); tkn != NULL;
+                 tkn = prv_find_key_child(qc->lwobj, parent, seg->name, seg->name_len, hash, tkn)) {
+                prv_query_child(qc, tkn, states << 1);
+            }
+            return;
+        } else if (!seg->descendant && seg->type == LWJSON_QUERY_INDEX && seg->start >= 0) {
+            if (parent->type == LWJSON_TYPE_ARRAY && (tkn = prv_get_child_at(parent, (size_t)seg->start)) != NULL) {
+                prv_query_child(qc, tkn, states << 1);
+            }
+            return;
+        }
+    }
+
+    /* Negative indexes need number of elements */
+    if (parent->type == LWJSON_TYPE_ARRAY) {
+        for (uint64_t m = states; m != 0; m &= m - 1) {
+            const lwjson_query_segment_t* seg = &qc->query->segments[prv_ctz64(m)];
+
+            if ((seg->type == LWJSON_QUERY_INDEX || seg->type == LWJSON_QUERY_SLICE)
+                && (seg->start < 0 || seg->end < 0)) {
+#if LWJSON_CFG_CHILD_INDEX
+                cnt = parent->child_cnt;
+#else
+                for (tkn = lwjson_get_first_child(parent); tkn != NULL; tkn = lwjson_get_next(tkn), ++cnt) {}
+#endif /* LWJSON_CFG_CHILD_INDEX */
+                break;
+            }
+        }
+    }
+
+    for (tkn = lwjson_get_first_child(parent); tkn != NULL; tkn = lwjson_get_next(tkn), ++pos) {
+        uint64_t next = 0;
+
+        for (uint64_t m = states; m != 0; m &= m - 1) {
+            uint32_t i = prv_ctz64(m);
+            const lwjson_query_segment_t* seg = &qc->query->segments[i];
+
+            /* Recursive descent stays active in all descendants */
+            if (seg->descendant) {
+                next |= (uint64_t)1 << i;
+            }
+            if (prv_query_match(qc->lwobj, seg, parent, tkn, pos, cnt)) {
+                next |= (uint64_t)1 << (i + 1);
+            }
+        }
+        if (next != 0) {
+            prv_query_child(qc, tkn, next);
+        }
+    }
+}
+
+/**
+ * \brief           Find all tokens matching compiled query in single walk of the tree
+ *
+ * Callback function is called for every matched token, in document order.
+ * Token matched by more branches of the query, such as with `$..*..a`, is reported only once.
+ *
+ * \param[in]       lwobj: JSON instance with parsed JSON string
+ * \param[in]       token: Root token to start search at, referred to as `$` in the query.
+ *                      Set to `NULL` to use root token of LwJSON object
+ * \param[in]       query: Query compiled with \ref lwjson_query_compile
+ * \param[in]       evt_fn: Callback function called for every matched token
+ * \param[in]       user_data: User data passed to callback function
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_query(lwjson_t* lwobj, const lwjson_token_t* token, const lwjson_query_t* query,
+             lwjson_query_callback_fn evt_fn, void* user_data) {
+    lwjson_int_query_t qc = {.lwobj = lwobj, .query = query, .evt_fn = evt_fn, .user_data = user_data};
+
+    if (lwobj == NULL || query == NULL || evt_fn == NULL || !lwobj->flags.parsed) {
+        return lwjsonERRPAR;
+    }
+    if (token == NULL) {
+        token = lwjson_get_first_token(lwobj);
+    }
+    if (query->segments_cnt == 0) {
+        evt_fn(lwobj, token, user_data);
+    } else if (token->type == LWJSON_TYPE_OBJECT || token->type == LWJSON_TYPE_ARRAY) {
+        prv_query(&qc, token, 1);
+    }
+    return lwjsonOK;
+}
+
+#endif /* LWJSON_CFG_QUERY */
+
+#if LWJSON_CFG_TAPE
+
+/* Tape word is tag in upper 8 bits, followed by flags and payload */
+#define LWJSON_TAPE_TAG(w)             ((uint8_t)((w) >> 56))
+#define LWJSON_TAPE_FLAG_KEYED         ((uint64_t)1 << 55) /* Value is preceded by key words */
+#define LWJSON_TAPE_FLAG_ESCAPED       ((uint64_t)1 << 54) /* String contains escape sequences */
+#define LWJSON_TAPE_PAYLOAD_MASK       (((uint64_t)1 << 54) - 1)
+#define LWJSON_TAPE_PAYLOAD(w)         ((w) & LWJSON_TAPE_PAYLOAD_MASK)
+#define LWJSON_TAPE_WORD(tag, payload) (((uint64_t)(tag) << 56) | (uint64_t)(payload))
+
+/*
+ * Tape tags.
+ *
+ * Object and array start words hold number of words up to and including matching end word,
+ * end words hold distance back to the start word.
+ * Keys, strings and numbers take two words, string offset and length or raw value in the second word.
+ * Literals take one word. Tape ends with word of value `0`.
+ */
+#define LWJSON_TAPE_TAG_END        0x00
+#define LWJSON_TAPE_TAG_OBJECT     '{'
+#define LWJSON_TAPE_TAG_OBJECT_END '}'
+#define LWJSON_TAPE_TAG_ARRAY      '['
+#define LWJSON_TAPE_TAG_ARRAY_END  ']'
+#define LWJSON_TAPE_TAG_KEY        ':'
+#define LWJSON_TAPE_TAG_STRING     '"'
+#define LWJSON_TAPE_TAG_NUM_INT    'l'
+#define LWJSON_TAPE_TAG_NUM_REAL   'd'
+#define LWJSON_TAPE_TAG_TRUE       't'
+#define LWJSON_TAPE_TAG_FALSE      'f'
+#define LWJSON_TAPE_TAG_NULL       'n'
+
+/**
+ * \brief           Write words to the end of the tape
+ * \param[in,out]   tobj: LwJSON tape instance
+ * \param[in]       w0: First word to write
+ * \param[in]       w1: Second word to write, used only if `cnt == 2`
+ * \param[in]       cnt: Number of words to write, `1` or `2`
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+static lwjsonr_t
+prv_tape_put(lwjson_tape_t* tobj, uint64_t w0, uint64_t w1, size_t cnt) {
+    if (cnt > tobj->tape_len - tobj->tape_used) {
+        return lwjsonERRMEM;
+    }
+    tobj->tape[tobj->tape_used++] = w0;
+    if (cnt > 1) {
+        tobj->tape[tobj->tape_used++] = w1;
+    }
+    return lwjsonOK;
+}
+
+/**
+ * \brief           Get number of words of the value, including all words of its subtree
+ * \param[in]       w: First word of the value
+ * \return          Number of words
+ */
+static size_t
+prv_tape_word_cnt(const lwjson_tape_word_t* w) {
+    switch (LWJSON_TAPE_TAG(*w)) {
+        case LWJSON_TAPE_TAG_OBJECT:
+        case LWJSON_TAPE_TAG_ARRAY: return (size_t)LWJSON_TAPE_PAYLOAD(*w);
+        case LWJSON_TAPE_TAG_KEY:
+        case LWJSON_TAPE_TAG_STRING:
+        case LWJSON_TAPE_TAG_NUM_INT:
+        case LWJSON_TAPE_TAG_NUM_REAL: return 2;
+        default: return 1;
+    }
+}
+
+/**
+ * \brief           Setup LwJSON tape instance for parsing JSON strings
+ * \param[in,out]   tobj: LwJSON tape instance
+ * \param[in]       tape: Pointer to array of tape words used for parsing
+ * \param[in]       tape_len: Number of tape words
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_tape_init(lwjson_tape_t* tobj, lwjson_tape_word_t* tape, size_t tape_len) {
+    LWJSON_MEMSET(tobj, 0x00, sizeof(*tobj));
+    tobj->tape = tape;
+    tobj->tape_len = tape_len;
+    return lwjsonOK;
+}
+
+/**
+ * \brief           Parse JSON data with length parameter to the tape
+ * JSON format must be complete and must comply with RFC4627
+ * \param[in,out]   tobj: LwJSON tape instance
+ * \param[in]       json_data: JSON string to parse
+ * \param[in]       json_len: JSON data length
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_tape_parse_ex(lwjson_tape_t* tobj, const void* json_data, size_t json_len) {
+    lwjsonr_t res;
+    lwjson_int_str_t pobj = {.start = json_data, .len = json_len, .p = json_data};
+    size_t to = 0; /* Tape index of currently open object or array */
+    uint64_t keyed;
+    uint8_t tag;
+
+    /* Check input parameters */
+    if (tobj == NULL || json_data == NULL || json_len == 0) {
+        return lwjsonERRPAR;
+    }
+    prv_str_init(&pobj);
+    tobj->flags.parsed = 0;
+    tobj->tape_used = 0;
+    tobj->json_data = json_data;
+
+    /* First parse, root has no parent */
+    res = prv_skip_blank(&pobj);
+    if (res != lwjsonOK) {
+        goto ret;
+    }
+    if (*pobj.p != '{' && *pobj.p != '[') {
+        res = lwjsonERRJSON;
+        goto ret;
+    }
+    res = prv_tape_put(tobj, LWJSON_TAPE_WORD(*pobj.p, LWJSON_TAPE_PAYLOAD_MASK), 0, 1);
+    if (res != lwjsonOK) {
+        goto ret;
+    }
+    res = prv_check_valid_char_after_open_bracket(&pobj, *pobj.p++ == '{' ? LWJSON_TYPE_OBJECT : LWJSON_TYPE_ARRAY);
+    if (res != lwjsonOK) {
+        goto ret;
+    }
+
+    /* Process all characters as indicated by input user */
+    while (!prv_str_is_end(&pobj)) {
+        /* Filter out blanks */
+        res = prv_skip_blank(&pobj);
+        if (res != lwjsonOK) {
+            goto ret;
+        }
+        if (*pobj.p == ',') {
+            ++pobj.p;
+            continue;
+        }
+
+        /* Check if end of object or array */
+        tag = LWJSON_TAPE_TAG(tobj->tape[to]);
+        if (*pobj.p == (tag == LWJSON_TAPE_TAG_OBJECT ? '}' : ']')) {
+            size_t parent = (size_t)LWJSON_TAPE_PAYLOAD(tobj->tape[to]);
+
+            res = prv_tape_put(tobj,
+                               LWJSON_TAPE_WORD(tag == LWJSON_TAPE_TAG_OBJECT ? LWJSON_TAPE_TAG_OBJECT_END
+                                                                              : LWJSON_TAPE_TAG_ARRAY_END,
+                                                tobj->tape_used - to),
+                               0, 1);
+            if (res != lwjsonOK) {
+                goto ret;
+            }
+            tobj->tape[to] = (tobj->tape[to] & ~LWJSON_TAPE_PAYLOAD_MASK) | (uint64_t)(tobj->tape_used - to);
+            ++pobj.p;
+
+            /* End of string if root is closed, check if properly terminated */
+            if (parent == LWJSON_TAPE_PAYLOAD_MASK) {
+                prv_skip_blank(&pobj);
+                res = prv_str_is_end(&pobj) ? lwjsonOK : lwjsonERR;
+                if (res == lwjsonOK) {
+                    res = prv_tape_put(tobj, LWJSON_TAPE_WORD(LWJSON_TAPE_TAG_END, 0), 0, 1);
+                }
+                goto ret;
+            }
+            to = parent;
+            continue;
+        }
+
+        /* If object type is not array, first thing is property that starts with quotes */
+        keyed = 0;
+        if (tag == LWJSON_TAPE_TAG_OBJECT) {
+            const char* name;
+            size_t name_len;
+            uint8_t escaped;
+
+            if (*pobj.p != '"') {
+                res = lwjsonERRJSON;
+                goto ret;
+            }
+            res = prv_parse_property_name(&pobj, &name, &name_len, &escaped);
+            if (res != lwjsonOK) {
+                goto ret;
+            }
+            res = prv_tape_put(tobj,
+                               LWJSON_TAPE_WORD(LWJSON_TAPE_TAG_KEY, name - pobj.start)
+                                   | (escaped ? LWJSON_TAPE_FLAG_ESCAPED : 0),
+                               name_len, 2);
+            if (res != lwjsonOK) {
+                goto ret;
+            }
+            keyed = LWJSON_TAPE_FLAG_KEYED;
+        }
+
+        /* Check next character to process */
+        switch (*pobj.p) {
+            case '{':
+            case '[':
+                res = prv_tape_put(tobj, LWJSON_TAPE_WORD(*pobj.p, to) | keyed, 0, 1);
+                if (res != lwjsonOK) {
+                    goto ret;
+                }
+                to = tobj->tape_used - 1;
+                res = prv_check_valid_char_after_open_bracket(&pobj, *pobj.p++ == '{' ? LWJSON_TYPE_OBJECT
+                                                                                        : LWJSON_TYPE_ARRAY);
+                if (res != lwjsonOK) {
+                    goto ret;
+                }
+                continue;
+            case '"': {
+                const char* str;
+                size_t str_len;
+                uint8_t escaped;
+
+                res = prv_parse_string(&pobj, &str, &str_len, &escaped);
+                if (res != lwjsonOK) {
+                    goto ret;
+                }
+                res = prv_tape_put(tobj,
+                                   LWJSON_TAPE_WORD(LWJSON_TAPE_TAG_STRING, str - pobj.start) | keyed
+                                       | (escaped ? LWJSON_TAPE_FLAG_ESCAPED : 0),
+                                   str_len, 2);
+                break;
+            }
+            case 't':
+            case 'f':
+            case 'n': {
+                lwjson_type_t type;
+
+                res = prv_parse_literal(&pobj, &type);
+                if (res != lwjsonOK) {
+                    goto ret;
+                }
+                if (type == LWJSON_TYPE_TRUE) {
+                    tag = LWJSON_TAPE_TAG_TRUE;
+                } else if (type == LWJSON_TYPE_FALSE) {
+                    tag = LWJSON_TAPE_TAG_FALSE;
+                } else {
+                    tag = LWJSON_TAPE_TAG_NULL;
+                }
+                res = prv_tape_put(tobj, LWJSON_TAPE_WORD(tag, 0) | keyed, 0, 1);
+                break;
+            }
+            default: {
+                lwjson_type_t type;
+                lwjson_real_t real_num;
+                lwjson_int_t int_num;
+                uint64_t val = 0;
+
+                if (*pobj.p != '-' && (*pobj.p < '0' || *pobj.p > '9')) {
+                    res = lwjsonERRJSON;
+                    goto ret;
+                }
+                res = prv_parse_number(&pobj, &type, &real_num, &int_num);
+                if (res != lwjsonOK) {
+                    goto ret;
+                }
+                if (type == LWJSON_TYPE_NUM_INT) {
+                    LWJSON_MEMCPY(&val, &int_num, sizeof(int_num));
+                } else {
+                    LWJSON_MEMCPY(&val, &real_num, sizeof(real_num));
+                }
+                tag = type == LWJSON_TYPE_NUM_INT ? LWJSON_TAPE_TAG_NUM_INT : LWJSON_TAPE_TAG_NUM_REAL;
+                res = prv_tape_put(tobj, LWJSON_TAPE_WORD(tag, 0) | keyed, val, 2);
+                break;
+            }
+        }
+        if (res != lwjsonOK) {
+            goto ret;
+        }
+
+        /* Check what are values after the token value */
+        res = prv_check_after_value(&pobj);
+        if (res != lwjsonOK) {
+            goto ret;
+        }
+    }
+
+    /* Input ended before root object or array was closed */
+    res = lwjsonERRJSON;
+ret:
+    if (res == lwjsonOK) {
+        tobj->flags.parsed = 1;
+    }
+    return res;
+}
+
+/**
+ * \brief           Parse input JSON format to the tape
+ * JSON format must be complete and must comply with RFC4627
+ * \param[in,out]   tobj: LwJSON tape instance
+ * \param[in]       json_str: JSON string to parse
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_tape_parse(lwjson_tape_t* tobj, const char* json_str) {
+    return lwjson_tape_parse_ex(tobj, json_str, strlen(json_str));
+}
+
+/**
+ * \brief           Get root object or array of parsed tape
+ * \param[in]       tobj: LwJSON tape instance
+ * \return          First word of root value on success, `NULL` if tape is not parsed
+ */
+const lwjson_tape_word_t*
+lwjson_tape_get_root(const lwjson_tape_t* tobj) {
+    return tobj != NULL && tobj->flags.parsed ? tobj->tape : NULL;
+}
+
+/**
+ * \brief           Get type of tape value
+ * \param[in]       w: First word of the value
+ * \return          Value type
+ */
+lwjson_type_t
+lwjson_tape_get_type(const lwjson_tape_word_t* w) {
+    switch (LWJSON_TAPE_TAG(*w)) {
+        case LWJSON_TAPE_TAG_OBJECT: return LWJSON_TYPE_OBJECT;
+        case LWJSON_TAPE_TAG_ARRAY: return LWJSON_TYPE_ARRAY;
+        case LWJSON_TAPE_TAG_STRING: return LWJSON_TYPE_STRING;
+        case LWJSON_TAPE_TAG_NUM_INT: return LWJSON_TYPE_NUM_INT;
+        case LWJSON_TAPE_TAG_NUM_REAL: return LWJSON_TYPE_NUM_REAL;
+        case LWJSON_TAPE_TAG_TRUE: return LWJSON_TYPE_TRUE;
+        case LWJSON_TAPE_TAG_FALSE: return LWJSON_TYPE_FALSE;
+        default: return LWJSON_TYPE_NULL;
+    }
+}
+
+/**
+ * \brief           Get first child value of object or array
+ * \param[in]       w: First word of object or array value
+ * \return          First word of the first child or `NULL` if value is not object or array or it is empty
+ */
+const lwjson_tape_word_t*
+lwjson_tape_get_first_child(const lwjson_tape_word_t* w) {
+    if (w == NULL || (LWJSON_TAPE_TAG(*w) != LWJSON_TAPE_TAG_OBJECT && LWJSON_TAPE_TAG(*w) != LWJSON_TAPE_TAG_ARRAY)
+        || LWJSON_TAPE_PAYLOAD(*w) == 2) {
+        return NULL;
+    }
+    ++w;
+    return LWJSON_TAPE_TAG(*w) == LWJSON_TAPE_TAG_KEY ? w + 2 : w;
+}
+
+/**
+ * \brief           Get next sibling value, whole subtree of the value is skipped at once
+ * \param[in]       w: First word of the value
+ * \return          First word of the next value in the same object or array or `NULL` if value is the last one
+ */
+const lwjson_tape_word_t*
+lwjson_tape_get_next(const lwjson_tape_word_t* w) {
+    if (w == NULL) {
+        return NULL;
+    }
+    w += prv_tape_word_cnt(w);
+    switch (LWJSON_TAPE_TAG(*w)) {
+        case LWJSON_TAPE_TAG_END:
+        case LWJSON_TAPE_TAG_OBJECT_END:
+        case LWJSON_TAPE_TAG_ARRAY_END: return NULL;
+        case LWJSON_TAPE_TAG_KEY: return w + 2;
+        default: return w;
+    }
+}
+
+/**
+ * \brief           Get name of the value in object
+ * \param[in]       tobj: LwJSON tape instance
+ * \param[in]       w: First word of the value
+ * \param[out]      name_len: Pointer to variable holding length of name.
+ *                      Set to `NULL` if not used
+ * \return          Pointer to name or `NULL` if value has no name
+ */
+const char*
+lwjson_tape_get_name(const lwjson_tape_t* tobj, const lwjson_tape_word_t* w, size_t* name_len) {
+    if (w == NULL || (*w & LWJSON_TAPE_FLAG_KEYED) == 0) {
+        return NULL;
+    }
+    if (name_len != NULL) {
+        *name_len = (size_t)w[-1];
+    }
+    return tobj->json_data + LWJSON_TAPE_PAYLOAD(w[-2]);
+}
+
+/**
+ * \brief           Get string value
+ * \param[in]       tobj: LwJSON tape instance
+ * \param[in]       w: First word of the value with string type
+ * \param[out]      str_len: Pointer to variable holding length of string.
+ *                      Set to `NULL` if not used
+ * \return          Pointer to string or `NULL` if invalid value type
+ */
+const char*
+lwjson_tape_get_val_string(const lwjson_tape_t* tobj, const lwjson_tape_word_t* w, size_t* str_len) {
+    if (w == NULL || LWJSON_TAPE_TAG(*w) != LWJSON_TAPE_TAG_STRING) {
+        return NULL;
+    }
+    if (str_len != NULL) {
+        *str_len = (size_t)w[1];
+    }
+    return tobj->json_data + LWJSON_TAPE_PAYLOAD(w[0]);
+}
+
+/**
+ * \brief           Get value for \ref LWJSON_TYPE_NUM_INT type
+ * \param[in]       w: First word of the value with integer type
+ * \return          Int number if type is integer, `0` otherwise
+ */
+lwjson_int_t
+lwjson_tape_get_val_int(const lwjson_tape_word_t* w) {
+    lwjson_int_t val = 0;
+
+    if (w != NULL && LWJSON_TAPE_TAG(*w) == LWJSON_TAPE_TAG_NUM_INT) {
+        LWJSON_MEMCPY(&val, &w[1], sizeof(val));
+    }
+    return val;
+}
+
+/**
+ * \brief           Get value for \ref LWJSON_TYPE_NUM_REAL type
+ * \param[in]       w: First word of the value with real type
+ * \return          Real number if type is real, `0` otherwise
+ */
+lwjson_real_t
+lwjson_tape_get_val_real(const lwjson_tape_word_t* w) {
+    lwjson_real_t val = 0;
+
+    if (w != NULL && LWJSON_TAPE_TAG(*w) == LWJSON_TAPE_TAG_NUM_REAL) {
+        LWJSON_MEMCPY(&val, &w[1], sizeof(val));
+    }
+    return val;
+}
+
+/**
+ * \brief           Input recursive function for find operation on the tape
+ * \param[in]       tobj: LwJSON tape instance
+ * \param[in]       parent: First word of parent value of type \ref LWJSON_TYPE_ARRAY or LWJSON_TYPE_OBJECT
+ * \param[in]       path: Path to search for starting this value further
+ * \return          First word of found value on success, `NULL` otherwise
+ */
+static const lwjson_tape_word_t*
+prv_tape_find(const lwjson_tape_t* tobj, const lwjson_tape_word_t* parent, const char* path) {
+    lwjson_path_segment_t seg;
+    const lwjson_tape_word_t *w, *tmp;
+    uint8_t is_last;
+
+    /* Get path segments */
+    if (!prv_path_segment(&path, &seg, &is_last)) {
+        return NULL;
+    }
+    if (seg.type == LWJSON_PATH_KEY) {
+        if (lwjson_tape_get_type(parent) != LWJSON_TYPE_OBJECT) {
+            return NULL;
+        }
+        for (w = lwjson_tape_get_first_child(parent); w != NULL; w = lwjson_tape_get_next(w)) {
+            if ((size_t)w[-1] == seg.name_len
+                && !strncmp(tobj->json_data + LWJSON_TAPE_PAYLOAD(w[-2]), seg.name, seg.name_len)) {
+                tmp = is_last ? w : prv_tape_find(tobj, w, path);
+                if (tmp != NULL) {
+                    return tmp;
+                }
+            }
+        }
+        return NULL;
+    }
+
+    /* Parent must be array */
+    if (lwjson_tape_get_type(parent) != LWJSON_TYPE_ARRAY) {
+        return NULL;
+    }
+    if (seg.type == LWJSON_PATH_INDEX) {
+        /* Skip whole subtrees of preceding values */
+        for (w = lwjson_tape_get_first_child(parent); w != NULL && seg.index > 0;
+             w = lwjson_tape_get_next(w), --seg.index) {}
+        if (w == NULL || is_last) {
+            return w;
+        }
+        return prv_tape_find(tobj, w, path);
+    }
+
+    /* Scan all indexes and get first match */
+    for (w = lwjson_tape_get_first_child(parent); w != NULL; w = lwjson_tape_get_next(w)) {
+        tmp = prv_tape_find(tobj, w, path);
+        if (tmp != NULL) {
+            return tmp;
+        }
+    }
+    return NULL;
+}
+
+/**
+ * \brief           Find first match in the given path for JSON entry on the tape
+ * JSON must be valid and parsed with \ref lwjson_tape_parse function
+ * \param[in]       tobj: LwJSON tape instance with parsed JSON string
+ * \param[in]       path: Path with dot-separated entries to search for the JSON key to return
+ * \return          First word of found value on success, `NULL` if value cannot be found
+ */
+const lwjson_tape_word_t*
+lwjson_tape_find(const lwjson_tape_t* tobj, const char* path) {
+    return lwjson_tape_find_ex(tobj, NULL, path);
+}
+
+/**
+ * \brief           Find first match in the given path for JSON path on the tape
+ * JSON must be valid and parsed with \ref lwjson_tape_parse function
+ *
+ * \param[in]       tobj: LwJSON tape instance with parsed JSON string
+ * \param[in]       w: First word of root value to start search at.
+ *                      Value must be type \ref LWJSON_TYPE_OBJECT or \ref LWJSON_TYPE_ARRAY.
+ *                      Set to `NULL` to use root value of the tape
+ * \param[in]       path: path with dot-separated entries to search for JSON key
+ * \return          First word of found value on success, `NULL` if value cannot be found
+ */
+const lwjson_tape_word_t*
+lwjson_tape_find_ex(const lwjson_tape_t* tobj, const lwjson_tape_word_t* w, const char* path) {
+    if (tobj == NULL || !tobj->flags.parsed || path == NULL) {
+        return NULL;
+    }
+    if (w == NULL) {
+        w = tobj->tape;
+    }
+    if (lwjson_tape_get_type(w) != LWJSON_TYPE_ARRAY && lwjson_tape_get_type(w) != LWJSON_TYPE_OBJECT) {
+        return NULL;
+    }
+    return prv_tape_find(tobj, w, path);
+}
+
+#endif /* LWJSON_CFG_TAPE */
+
+#if LWJSON_CFG_ON_DEMAND
+
+static lwjsonr_t prv_od_skip(lwjson_od_t* od, lwjson_int_str_t* pobj);
+
+/**
+ * \brief           Check state of on-demand iterator before the operation
+ * \param[in]       od: On-demand iterator
+ * \param[in]       need_value: Set to `1` if operation needs iterator to be at the value
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+static lwjsonr_t
+prv_od_check(const lwjson_od_t* od, uint8_t need_value) {
+    if (od == NULL) {
+        return lwjsonERRPAR;
+    } else if (od->flags.error) {
+        return lwjsonERRJSON;
+    } else if (need_value && !od->flags.pending) {
+        return lwjsonERRPAR;
+    }
+    return lwjsonOK;
+}
+
+/**
+ * \brief           Setup internal string object at current position of on-demand iterator
+ * \param[in]       od: On-demand iterator
+ * \param[out]      pobj: String object to setup
+ */
+static void
+prv_od_str(const lwjson_od_t* od, lwjson_int_str_t* pobj) {
+    pobj->start = od->json_data;
+    pobj->len = od->len;
+    pobj->readable = od->len;
+    pobj->p = od->json_data + od->pos;
+#if LWJSON_CFG_STRUCT_INDEX
+    pobj->blk.pos = SIZE_MAX;
+#endif /* LWJSON_CFG_STRUCT_INDEX */
+}
+
+/**
+ * \brief           Save position of internal string object to on-demand iterator
+ * \param[in,out]   od: On-demand iterator
+ * \param[in]       pobj: String object
+ * \param[in]       res: Result of the operation. Iterator cannot be used anymore after JSON format error
+ * \return          Value of `res` parameter
+ */
+static lwjsonr_t
+prv_od_save(lwjson_od_t* od, const lwjson_int_str_t* pobj, lwjsonr_t res) {
+    od->pos = (size_t)(pobj->p - pobj->start);
+    if (res != lwjsonOK && res != lwjsonODEND && res != lwjsonERRPAR) {
+        od->flags.error = 1;
+    }
+    return res;
+}
+
+/**
+ * \brief           Get type of the value at iterator position, without consuming it
+ * \param[in]       pobj: String object at the beginning of the value
+ * \param[out]      tout: Pointer to output value type
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+static lwjsonr_t
+prv_od_peek_type(const lwjson_int_str_t* pobj, lwjson_type_t* tout) {
+    switch (*pobj->p) {
+        case '{': *tout = LWJSON_TYPE_OBJECT; break;
+        case '[': *tout = LWJSON_TYPE_ARRAY; break;
+        case '"': *tout = LWJSON_TYPE_STRING; break;
+        case 't': *tout = LWJSON_TYPE_TRUE; break;
+        case 'f': *tout = LWJSON_TYPE_FALSE; break;
+        case 'n': *tout = LWJSON_TYPE_NULL; break;
+        default: {
+            lwjson_int_str_t num = *pobj;
+            const char* start;
+
+            if (*pobj->p != '-' && (*pobj->p < '0' || *pobj->p > '9')) {
+                return lwjsonERRJSON;
+            }
+            return prv_scan_number(&num, tout, &start);
+        }
+    }
+    return lwjsonOK;
+}
+
+/**
+ * \brief           Enter object or array at iterator position
+ * \param[in,out]   od: On-demand iterator
+ * \param[in,out]   pobj: String object at the beginning of the value
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+static lwjsonr_t
+prv_od_enter(lwjson_od_t* od, lwjson_int_str_t* pobj) {
+    if (*pobj->p != '{' && *pobj->p != '[') {
+        return lwjsonERRPAR;
+    }
+    if (od->depth >= LWJSON_ARRAYSIZE(od->stack)) {
+        return lwjsonERRMEM;
+    }
+    od->stack[od->depth++] = (uint8_t)(*pobj->p++ == '{' ? LWJSON_TYPE_OBJECT : LWJSON_TYPE_ARRAY);
+    od->flags.first = 1;
+    od->flags.pending = 0;
+    return lwjsonOK;
+}
+
+/**
+ * \brief           Skip primitive value at iterator position
+ * \param[in,out]   od: On-demand iterator
+ * \param[in,out]   pobj: String object at the beginning of the value
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+static lwjsonr_t
+prv_od_skip_primitive(lwjson_od_t* od, lwjson_int_str_t* pobj) {
+    lwjsonr_t res;
+    lwjson_type_t type;
+
+    if (*pobj->p == '"') {
+        const char* str;
+        size_t str_len;
+        uint8_t escaped;
+
+        res = prv_parse_string(pobj, &str, &str_len, &escaped);
+    } else if (*pobj->p == 't' || *pobj->p == 'f' || *pobj->p == 'n') {
+        res = prv_parse_literal(pobj, &type);
+    } else if (*pobj->p == '-' || (*pobj->p >= '0' && *pobj->p <= '9')) {
+        const char* start;
+
+        res = prv_scan_number(pobj, &type, &start);
+    } else {
+        res = lwjsonERRJSON;
+    }
+    if (res == lwjsonOK) {
+        od->flags.pending = 0;
+    }
+    return res;
+}
+
+/**
+ * \brief           Move iterator to the next element of current object or array
+ * \param[in,out]   od: On-demand iterator
+ * \param[in,out]   pobj: String object at iterator position
+ * \param[out]      pname: Pointer to write name of the element to, `NULL` for array elements
+ * \param[out]      pname_len: Pointer to write length of the name to
+ * \return          \ref lwjsonOK on success, \ref lwjsonODEND when object or array has ended,
+ *                      member of \ref lwjsonr_t otherwise
+ */
+static lwjsonr_t
+prv_od_next(lwjson_od_t* od, lwjson_int_str_t* pobj, const char** pname, size_t* pname_len) {
+    lwjsonr_t res;
+    lwjson_type_t type;
+
+    *pname = NULL;
+    *pname_len = 0;
+    if (od->depth == 0) {
+        return lwjsonERRPAR;
+    }
+
+    /* Value at current position was not consumed by application */
+    if (od->flags.pending) {
+        res = prv_od_skip(od, pobj);
+        if (res != lwjsonOK) {
+            return res;
+        }
+    }
+    res = prv_skip_blank(pobj);
+    if (res != lwjsonOK) {
+        return res;
+    }
+
+    /* Check end of object or array */
+    type = (lwjson_type_t)od->stack[od->depth - 1];
+    if (*pobj->p == (type == LWJSON_TYPE_OBJECT ? '}' : ']')) {
+        ++pobj->p;
+        --od->depth;
+        od->flags.first = 0;
+        return lwjsonODEND;
+    }
+    if (!od->flags.first) {
+        if (*pobj->p++ != ',') {
+            return lwjsonERRJSON;
+        }
+        res = prv_skip_blank(pobj);
+        if (res != lwjsonOK) {
+            return res;
+        }
+    }
+    od->flags.first = 0;
+
+    /* Objects have property name before the value */
+    if (type == LWJSON_TYPE_OBJECT) {
+        uint8_t escaped;
+
+        if (*pobj->p != '"') {
+            return lwjsonERRJSON;
+        }
+        res = prv_parse_property_name(pobj, pname, pname_len, &escaped);
+        if (res != lwjsonOK) {
+            return res;
+        }
+    }
+    if ((size_t)(pobj->p - pobj->start) >= pobj->len
+        || (*pobj->p != '{' && *pobj->p != '[' && *pobj->p != '"' && *pobj->p != 't' && *pobj->p != 'f'
+            && *pobj->p != 'n' && *pobj->p != '-' && (*pobj->p < '0' || *pobj->p > '9'))) {
+        return lwjsonERRJSON;
+    }
+    od->flags.pending = 1;
+    return lwjsonOK;
+}
+
+/**
+ * \brief           Skip value at iterator position, including all nested values
+ * \param[in,out]   od: On-demand iterator
+ * \param[in,out]   pobj: String object at the beginning of the value
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+static lwjsonr_t
+prv_od_skip(lwjson_od_t* od, lwjson_int_str_t* pobj) {
+    lwjsonr_t res;
+    const char* name;
+    size_t name_len;
+    uint8_t depth;
+
+    if (*pobj->p != '{' && *pobj->p != '[') {
+        return prv_od_skip_primitive(od, pobj);
+    }
+
+    /* Walk nested values with the same iterator, until object or array at this level ends */
+    depth = od->depth;
+    res = prv_od_enter(od, pobj);
+    while (res == lwjsonOK && od->depth > depth) {
+        res = prv_od_next(od, pobj, &name, &name_len);
+        if (res == lwjsonOK) {
+            if (*pobj->p == '{' || *pobj->p == '[') {
+                res = prv_od_enter(od, pobj);
+            } else {
+                res = prv_od_skip_primitive(od, pobj);
+            }
+        } else if (res == lwjsonODEND) {
+            res = lwjsonOK;
+        }
+    }
+    return res;
+}
+
+/**
+ * \brief           Setup on-demand iterator at the beginning of JSON data
+ *
+ * Data is not parsed in advance, it is validated step by step as iterator moves forward.
+ * Iterator starts at the root value
+ *
+ * \param[in,out]   od: On-demand iterator
+ * \param[in]       json_data: JSON data to iterate
+ * \param[in]       json_len: JSON data length
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_od_init(lwjson_od_t* od, const void* json_data, size_t json_len) {
+    lwjson_int_str_t pobj = {.start = json_data, .len = json_len, .p = json_data};
+    lwjsonr_t res;
+
+    if (od == NULL || json_data == NULL || json_len == 0) {
+        return lwjsonERRPAR;
+    }
+    LWJSON_MEMSET(od, 0x00, sizeof(*od));
+    prv_str_init(&pobj);
+    od->json_data = pobj.start;
+    od->len = pobj.len;
+
+    res = prv_skip_blank(&pobj);
+    if (res == lwjsonOK && prv_str_is_end(&pobj)) {
+        res = lwjsonERRJSON;
+    }
+    od->flags.pending = 1;
+    return prv_od_save(od, &pobj, res);
+}
+
+/**
+ * \brief           Get type of the value at iterator position, without consuming it
+ * \param[in]       od: On-demand iterator
+ * \param[out]      type: Pointer to output value type
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_od_get_type(const lwjson_od_t* od, lwjson_type_t* type) {
+    lwjson_int_str_t pobj;
+    lwjsonr_t res;
+
+    res = prv_od_check(od, 1);
+    if (res != lwjsonOK) {
+        return res;
+    }
+    prv_od_str(od, &pobj);
+    return prv_od_peek_type(&pobj, type);
+}
+
+/**
+ * \brief           Enter object or array at iterator position
+ *
+ * Elements are then visited with \ref lwjson_od_next or \ref lwjson_od_find_field functions
+ *
+ * \param[in,out]   od: On-demand iterator
+ * \return          \ref lwjsonOK on success, \ref lwjsonERRPAR if value is not object or array,
+ *                      member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_od_enter(lwjson_od_t* od) {
+    lwjson_int_str_t pobj;
+    lwjsonr_t res;
+
+    res = prv_od_check(od, 1);
+    if (res != lwjsonOK) {
+        return res;
+    }
+    prv_od_str(od, &pobj);
+    return prv_od_save(od, &pobj, prv_od_enter(od, &pobj));
+}
+
+/**
+ * \brief           Move iterator to the next element of current object or array
+ *
+ * Current value is skipped if application did not consume it.
+ * When object or array ends, iterator continues in its parent, after the object or array
+ *
+ * \param[in,out]   od: On-demand iterator
+ * \param[out]      name: Pointer to write name of object element to, set to `NULL` for array elements.
+ *                      Set to `NULL` if not used
+ * \param[out]      name_len: Pointer to write length of the name to.
+ *                      Set to `NULL` if not used
+ * \return          \ref lwjsonOK on success, \ref lwjsonODEND when object or array has ended,
+ *                      member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_od_next(lwjson_od_t* od, const char** name, size_t* name_len) {
+    lwjson_int_str_t pobj;
+    const char* n;
+    size_t n_len;
+    lwjsonr_t res;
+
+    res = prv_od_check(od, 0);
+    if (res != lwjsonOK) {
+        return res;
+    }
+    prv_od_str(od, &pobj);
+    res = prv_od_next(od, &pobj, &n, &n_len);
+    if (name != NULL) {
+        *name = n;
+    }
+    if (name_len != NULL) {
+        *name_len = n_len;
+    }
+    return prv_od_save(od, &pobj, res);
 }
 
 /**
- * \brief           Check for character after opening bracket of array or object
- * \param[in,out]   pobj: JSON string
- * \param[in]       t: Token to check for type
- * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ * \brief           Find element with matching name in current object
+ *
+ * Search starts at the next element and goes forward only,
+ * elements before the iterator position are not searched again.
+ * Object is left when there is no match
+ *
+ * \param[in,out]   od: On-demand iterator, inside object
+ * \param[in]       name: NULL-terminated name of the element to find
+ * \return          \ref lwjsonOK when iterator is at the value of found element,
+ *                      \ref lwjsonODEND if object has ended without a match,
+ *                      member of \ref lwjsonr_t otherwise
  */
-static inline lwjsonr_t
-prv_check_valid_char_after_open_bracket(lwjson_int_str_t* pobj, lwjson_token_t* t) {
+lwjsonr_t
+lwjson_od_find_field(lwjson_od_t* od, const char* name) {
+    lwjson_int_str_t pobj;
+    const char* n;
+    size_t n_len, len;
     lwjsonr_t res;
 
-    /* Check next character after object open */
-    res = prv_skip_blank(pobj);
+    res = prv_od_check(od, 0);
     if (res != lwjsonOK) {
         return res;
     }
-    if (*pobj->p == '\0' || (t->type == LWJSON_TYPE_OBJECT && (*pobj->p != '"' && *pobj->p != '}'))
-        || (t->type == LWJSON_TYPE_ARRAY
-            && (*pobj->p != '"' && *pobj->p != ']' && *pobj->p != '[' && *pobj->p != '{' && *pobj->p != '-'
-                && (*pobj->p < '0' || *pobj->p > '9') && *pobj->p != 't' && *pobj->p != 'n' && *pobj->p != 'f'))) {
-        res = lwjsonERRJSON;
+    if (name == NULL || od->depth == 0 || od->stack[od->depth - 1] != LWJSON_TYPE_OBJECT) {
+        return lwjsonERRPAR;
     }
-    return res;
+    len = strlen(name);
+    prv_od_str(od, &pobj);
+    while ((res = prv_od_next(od, &pobj, &n, &n_len)) == lwjsonOK) {
+        if (n_len == len && strncmp(n, name, len) == 0) {
+            break;
+        }
+    }
+    return prv_od_save(od, &pobj, res);
 }
 
 /**
- * \brief           Setup LwJSON instance for parsing JSON strings
- * \param[in,out]   lwobj: LwJSON instance
- * \param[in]       tokens: Pointer to array of tokens used for parsing
- * \param[in]       tokens_len: Number of tokens
+ * \brief           Skip value at iterator position, including all nested values
+ * \param[in,out]   od: On-demand iterator
  * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
  */
 lwjsonr_t
-lwjson_init(lwjson_t* lwobj, lwjson_token_t* tokens, size_t tokens_len) {
-    LWJSON_MEMSET(lwobj, 0x00, sizeof(*lwobj));
-    LWJSON_MEMSET(tokens, 0x00, sizeof(*tokens) * tokens_len);
-    lwobj->tokens = tokens;
-    lwobj->tokens_len = tokens_len;
-    lwobj->first_token.type = LWJSON_TYPE_OBJECT;
-    return lwjsonOK;
+lwjson_od_skip(lwjson_od_t* od) {
+    lwjson_int_str_t pobj;
+    lwjsonr_t res;
+
+    res = prv_od_check(od, 1);
+    if (res != lwjsonOK) {
+        return res;
+    }
+    prv_od_str(od, &pobj);
+    return prv_od_save(od, &pobj, prv_od_skip(od, &pobj));
 }
 
 /**
- * \brief           Parse JSON data with length parameter
- * JSON format must be complete and must comply with RFC4627
- * \param[in,out]   lwobj: LwJSON instance
- * \param[in]       json_data: JSON string to parse
- * \param[in]       jsonČlen: JSON data length
+ * \brief           Skip all remaining elements of current object or array and leave it
+ * \param[in,out]   od: On-demand iterator
  * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
  */
 lwjsonr_t
-lwjson_parse_ex(lwjson_t* lwobj, const void* json_data, size_t json_len) {
-    lwjsonr_t res = lwjsonOK;
-    lwjson_token_t *t, *to;
-    lwjson_int_str_t pobj = {.start = json_data, .len = json_len, .p = json_data};
-
-    /* Check input parameters */
-    if (lwobj == NULL || json_data == NULL || json_len == 0) {
-        res = lwjsonERRPAR;
-        goto ret;
-    }
-
-    /* set first token */
-    to = &lwobj->first_token;
-
-    /* values from very beginning */
-    lwobj->flags.parsed = 0;
-    lwobj->next_free_token_pos = 0;
-    LWJSON_MEMSET(to, 0x00, sizeof(*to));
+lwjson_od_exit(lwjson_od_t* od) {
+    lwjson_int_str_t pobj;
+    const char* n;
+    size_t n_len;
+    lwjsonr_t res;
 
-    /* First parse */
-    res = prv_skip_blank(&pobj);
+    res = prv_od_check(od, 0);
     if (res != lwjsonOK) {
-        goto ret;
-    }
-    if (*pobj.p == '{') {
-        to->type = LWJSON_TYPE_OBJECT;
-    } else if (*pobj.p == '[') {
-        to->type = LWJSON_TYPE_ARRAY;
-    } else {
-        res = lwjsonERRJSON;
-        goto ret;
+        return res;
     }
-    ++pobj.p;
-    res = prv_check_valid_char_after_open_bracket(&pobj, to);
-    if (res != lwjsonOK) {
-        goto ret;
+    if (od->depth == 0) {
+        return lwjsonERRPAR;
     }
+    prv_od_str(od, &pobj);
+    while ((res = prv_od_next(od, &pobj, &n, &n_len)) == lwjsonOK) {}
+    return prv_od_save(od, &pobj, res == lwjsonODEND ? lwjsonOK : res);
+}
 
-    /* Process all characters as indicated by input user */
-    while (pobj.p != NULL && *pobj.p != '\0' && (size_t)(pobj.p - pobj.start) < pobj.len) {
-        /* Filter out blanks */
-        res = prv_skip_blank(&pobj);
-        if (res != lwjsonOK) {
-            goto ret;
-        }
-        if (*pobj.p == ',') {
-            ++pobj.p;
-            continue;
-        }
-
-        /* Check if end of object or array*/
-        if (*pobj.p == (to->type == LWJSON_TYPE_OBJECT ? '}' : ']')) {
-            lwjson_token_t* parent = to->next;
-            to->next = NULL;
-            ++pobj.p;
-
-            /* End of string if to == NULL (no parent), check if properly terminated */
-            to = parent;
-            if (to == NULL) {
-                prv_skip_blank(&pobj);
-                res = (pobj.p == NULL || *pobj.p == '\0' || (size_t)(pobj.p - pobj.start) == pobj.len) ? lwjsonOK
-                                                                                                       : lwjsonERR;
-                goto ret;
-            }
-            continue;
-        }
-
-        /* Allocate new token */
-        t = prv_alloc_token(lwobj);
-        if (t == NULL) {
-            res = lwjsonERRMEM;
-            goto ret;
-        }
-
-        /* If object type is not array, first thing is property that starts with quotes */
-        if (to->type != LWJSON_TYPE_ARRAY) {
-            if (*pobj.p != '"') {
-                res = lwjsonERRJSON;
-                goto ret;
-            }
-            res = prv_parse_property_name(&pobj, t);
-            if (res != lwjsonOK) {
-                goto ret;
-            }
-        }
-
-        /* Add element to linked list */
-        if (to->u.first_child == NULL) {
-            to->u.first_child = t;
-        } else {
-            lwjson_token_t* c;
-            for (c = to->u.first_child; c->next != NULL; c = c->next) {}
-            c->next = t;
-        }
-
-        /* Check next character to process */
-        switch (*pobj.p) {
-            case '{':
-            case '[':
-                t->type = *pobj.p == '{' ? LWJSON_TYPE_OBJECT : LWJSON_TYPE_ARRAY;
-                ++pobj.p;
-
-                res = prv_check_valid_char_after_open_bracket(&pobj, t);
-                if (res != lwjsonOK) {
-                    goto ret;
-                }
-                t->next = to; /* Temporary saved as parent object */
-                to = t;
-                break;
-            case '"':
-                res = prv_parse_string(&pobj, &t->u.str.token_value, &t->u.str.token_value_len);
-                if (res == lwjsonOK) {
-                    t->type = LWJSON_TYPE_STRING;
-                } else {
-                    goto ret;
-                }
-                break;
-            case 't':
-                /* RFC4627 is lower-case only */
-                if (strncmp(pobj.p, "true", 4) == 0) {
-                    t->type = LWJSON_TYPE_TRUE;
-                    pobj.p += 4;
-                } else {
-                    res = lwjsonERRJSON;
-                    goto ret;
-                }
-                break;
-            case 'f':
-                /* RFC4627 is lower-case only */
-                if (strncmp(pobj.p, "false", 5) == 0) {
-                    t->type = LWJSON_TYPE_FALSE;
-                    pobj.p += 5;
-                } else {
-                    res = lwjsonERRJSON;
-                    goto ret;
-                }
-                break;
-            case 'n':
-                /* RFC4627 is lower-case only */
-                if (strncmp(pobj.p, "null", 4) == 0) {
-                    t->type = LWJSON_TYPE_NULL;
-                    pobj.p += 4;
-                } else {
-                    res = lwjsonERRJSON;
-                    goto ret;
-                }
-                break;
-            default:
-                if (*pobj.p == '-' || (*pobj.p >= '0' && *pobj.p <= '9')) {
-                    if (prv_parse_number(&pobj, &t->type, &t->u.num_real, &t->u.num_int) != lwjsonOK) {
-                        res = lwjsonERRJSON;
-                        goto ret;
-                    }
-                } else {
-                    res = lwjsonERRJSON;
-                    goto ret;
-                }
-                break;
-        }
-
-        /* Below code is used to check characters after valid tokens */
-        if (t->type == LWJSON_TYPE_ARRAY || t->type == LWJSON_TYPE_OBJECT) {
-            continue;
-        }
+/**
+ * \brief           Get number value at iterator position and consume it
+ * \param[in,out]   od: On-demand iterator
+ * \param[in]       type: Expected number type, \ref LWJSON_TYPE_NUM_INT or \ref LWJSON_TYPE_NUM_REAL
+ * \param[out]      fout: Pointer to output real-type variable. Used if type is REAL.
+ * \param[out]      iout: Pointer to output int-type variable. Used if type is INT.
+ * \return          \ref lwjsonOK on success, \ref lwjsonERRPAR if value is of different type,
+ *                      member of \ref lwjsonr_t otherwise
+ */
+static lwjsonr_t
+prv_od_get_number(lwjson_od_t* od, lwjson_type_t type, lwjson_real_t* fout, lwjson_int_t* iout) {
+    lwjson_int_str_t pobj;
+    lwjson_type_t t;
+    lwjsonr_t res;
 
-        /*
-         * Check what are values after the token value
-         *
-         * As per RFC4627, every token value may have one or more
-         * blank characters, followed by one of below options:
-         *  - Comma separator for next token
-         *  - End of array indication
-         *  - End of object indication
-         */
-        res = prv_skip_blank(&pobj);
-        if (res != lwjsonOK) {
-            goto ret;
-        }
-        /* Check if valid string is availabe after */
-        if (pobj.p == NULL || *pobj.p == '\0' || (*pobj.p != ',' && *pobj.p != ']' && *pobj.p != '}')) {
-            res = lwjsonERRJSON;
-            goto ret;
-        } else if (*pobj.p == ',') { /* Check to advance to next token immediatey */
-            ++pobj.p;
-        }
-    }
-    if (to != &lwobj->first_token || (to != NULL && to->next != NULL)) {
-        res = lwjsonERRJSON;
-        to = NULL;
-    }
-    if (to != NULL) {
-        if (to->type != LWJSON_TYPE_ARRAY && to->type != LWJSON_TYPE_OBJECT) {
-            res = lwjsonERRJSON;
-        }
-        to->token_name = NULL;
-        to->token_name_len = 0;
+    res = lwjson_od_get_type(od, &t);
+    if (res != lwjsonOK || t != type) {
+        return res != lwjsonOK ? res : lwjsonERRPAR;
     }
-ret:
+    prv_od_str(od, &pobj);
+    res = prv_parse_number(&pobj, NULL, fout, iout);
     if (res == lwjsonOK) {
-        lwobj->flags.parsed = 1;
+        od->flags.pending = 0;
     }
-    return res;
+    return prv_od_save(od, &pobj, res);
 }
 
 /**
- * \brief           Parse input JSON format
- * JSON format must be complete and must comply with RFC4627
- * \param[in,out]   lwobj: LwJSON instance
- * \param[in]       json_str: JSON string to parse
- * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ * \brief           Get integer value at iterator position and consume it
+ * \param[in,out]   od: On-demand iterator
+ * \param[out]      val: Pointer to output value
+ * \return          \ref lwjsonOK on success, \ref lwjsonERRPAR if value is not integer number,
+ *                      member of \ref lwjsonr_t otherwise
  */
 lwjsonr_t
-lwjson_parse(lwjson_t* lwobj, const char* json_str) {
-    return lwjson_parse_ex(lwobj, json_str, strlen(json_str));
+lwjson_od_get_int(lwjson_od_t* od, lwjson_int_t* val) {
+    lwjson_real_t real_num;
+
+    return prv_od_get_number(od, LWJSON_TYPE_NUM_INT, &real_num, val);
 }
 
 /**
- * \brief           Free token instances (specially used in case of dynamic memory allocation)
- * \param[in,out]   lwobj: LwJSON instance
- * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ * \brief           Get real value at iterator position and consume it
+ * \param[in,out]   od: On-demand iterator
+ * \param[out]      val: Pointer to output value
+ * \return          \ref lwjsonOK on success, \ref lwjsonERRPAR if value is not real number,
+ *                      member of \ref lwjsonr_t otherwise
  */
 lwjsonr_t
-lwjson_free(lwjson_t* lwobj) {
-    LWJSON_MEMSET(lwobj->tokens, 0x00, sizeof(*lwobj->tokens) * lwobj->tokens_len);
-    lwobj->flags.parsed = 0;
-    return lwjsonOK;
+lwjson_od_get_real(lwjson_od_t* od, lwjson_real_t* val) {
+    lwjson_int_t int_num;
+
+    return prv_od_get_number(od, LWJSON_TYPE_NUM_REAL, val, &int_num);
 }
 
 /**
- * \brief           Find first match in the given path for JSON entry
- * JSON must be valid and parsed with \ref lwjson_parse function
- * \param[in]       lwobj: JSON instance with parsed JSON string
- * \param[in]       path: Path with dot-separated entries to search for the JSON key to return
- * \return          Pointer to found token on success, `NULL` if token cannot be found
+ * \brief           Get string value at iterator position and consume it
+ * \note            String is not decoded, it points to input data
+ * \param[in,out]   od: On-demand iterator
+ * \param[out]      str: Pointer to write beginning of the string to
+ * \param[out]      str_len: Pointer to write length of the string to
+ * \return          \ref lwjsonOK on success, \ref lwjsonERRPAR if value is not string,
+ *                      member of \ref lwjsonr_t otherwise
  */
-const lwjson_token_t*
-lwjson_find(lwjson_t* lwobj, const char* path) {
-    if (lwobj == NULL || !lwobj->flags.parsed || path == NULL) {
-        return NULL;
+lwjsonr_t
+lwjson_od_get_string(lwjson_od_t* od, const char** str, size_t* str_len) {
+    lwjson_int_str_t pobj;
+    lwjsonr_t res;
+    uint8_t escaped;
+
+    res = prv_od_check(od, 1);
+    if (res != lwjsonOK) {
+        return res;
+    }
+    prv_od_str(od, &pobj);
+    if (*pobj.p != '"') {
+        return lwjsonERRPAR;
+    }
+    res = prv_parse_string(&pobj, str, str_len, &escaped);
+    if (res == lwjsonOK) {
+        od->flags.pending = 0;
     }
-    return prv_find(lwjson_get_first_token(lwobj), path);
+    return prv_od_save(od, &pobj, res);
 }
 
 /**
- * \brief           Find first match in the given path for JSON path
- * JSON must be valid and parsed with \ref lwjson_parse function
- *
- * \param[in]       lwobj: JSON instance with parsed JSON string
- * \param[in]       token: Root token to start search at.
- *                      Token must be type \ref LWJSON_TYPE_OBJECT or \ref LWJSON_TYPE_ARRAY.
- *                      Set to `NULL` to use root token of LwJSON object
- * \param[in]       path: path with dot-separated entries to search for JSON key
- * \return          Pointer to found token on success, `NULL` if token cannot be found
+ * \brief           Get boolean value at iterator position and consume it
+ * \param[in,out]   od: On-demand iterator
+ * \param[out]      val: Pointer to output value, `1` for `true` and `0` for `false`
+ * \return          \ref lwjsonOK on success, \ref lwjsonERRPAR if value is not boolean,
+ *                      member of \ref lwjsonr_t otherwise
  */
-const lwjson_token_t*
-lwjson_find_ex(lwjson_t* lwobj, const lwjson_token_t* token, const char* path) {
-    if (lwobj == NULL || !lwobj->flags.parsed || path == NULL) {
-        return NULL;
+lwjsonr_t
+lwjson_od_get_bool(lwjson_od_t* od, uint8_t* val) {
+    lwjson_int_str_t pobj;
+    lwjson_type_t type;
+    lwjsonr_t res;
+
+    res = prv_od_check(od, 1);
+    if (res != lwjsonOK) {
+        return res;
     }
-    if (token == NULL) {
-        token = lwjson_get_first_token(lwobj);
+    prv_od_str(od, &pobj);
+    if (*pobj.p != 't' && *pobj.p != 'f') {
+        return lwjsonERRPAR;
     }
-    if (token == NULL || (token->type != LWJSON_TYPE_ARRAY && token->type != LWJSON_TYPE_OBJECT)) {
-        return NULL;
+    res = prv_parse_literal(&pobj, &type);
+    if (res == lwjsonOK) {
+        *val = type == LWJSON_TYPE_TRUE;
+        od->flags.pending = 0;
     }
-    return prv_find(token, path);
+    return prv_od_save(od, &pobj, res);
 }
+
+#endif /* LWJSON_CFG_ON_DEMAND */
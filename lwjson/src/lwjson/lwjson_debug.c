@@ -45,10 +45,14 @@ typedef struct {
 /**
  * \brief           Print token value
  * \param[in]       prt: Token print instance
+ * \param[in]       lwobj: LwJSON instance used to parse the token
  * \param[in]       token: Token to print
  */
 static void
-prv_print_token(lwjson_token_print_t* prt, const lwjson_token_t* token) {
+prv_print_token(lwjson_token_print_t* prt, const lwjson_t* lwobj, const lwjson_token_t* token) {
+    const char* name;
+    size_t name_len;
+
 #define print_indent() printf("%.*s", (int)((prt->indent)), "\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t");
 
     if (token == NULL) {
@@ -57,8 +61,9 @@ prv_print_token(lwjson_token_print_t* prt, const lwjson_token_t* token) {
 
     /* Check if token has a name */
     print_indent();
-    if (token->token_name != NULL) {
-        printf("\"%.*s\":", (int)token->token_name_len, token->token_name);
+    name = lwjson_get_name(lwobj, token, &name_len);
+    if (name != NULL) {
+        printf("\"%.*s\":", (int)name_len, name);
     }
 
     /* Print different types */
@@ -66,11 +71,11 @@ prv_print_token(lwjson_token_print_t* prt, const lwjson_token_t* token) {
         case LWJSON_TYPE_OBJECT:
         case LWJSON_TYPE_ARRAY: {
             printf("%c", token->type == LWJSON_TYPE_OBJECT ? '{' : '[');
-            if (token->u.first_child != NULL) {
+            if (lwjson_get_first_child(token) != NULL) {
                 printf("\n");
                 ++prt->indent;
-                for (const lwjson_token_t* t = lwjson_get_first_child(token); t != NULL; t = t->next) {
-                    prv_print_token(prt, t);
+                for (const lwjson_token_t* t = lwjson_get_first_child(token); t != NULL; t = lwjson_get_next(t)) {
+                    prv_print_token(prt, lwobj, t);
                 }
                 --prt->indent;
                 print_indent();
@@ -79,7 +84,7 @@ prv_print_token(lwjson_token_print_t* prt, const lwjson_token_t* token) {
             break;
         }
         case LWJSON_TYPE_STRING: {
-            printf("\"%.*s\"", (int)lwjson_get_val_string_length(token), lwjson_get_val_string(token, NULL));
+            printf("\"%.*s\"", (int)lwjson_get_val_string_length(token), lwjson_get_val_string_ex(lwobj, token, NULL));
             break;
         }
         case LWJSON_TYPE_NUM_INT: {
@@ -104,7 +109,7 @@ prv_print_token(lwjson_token_print_t* prt, const lwjson_token_t* token) {
         }
         default: break;
     }
-    if (token->next != NULL) {
+    if (lwjson_get_next(token) != NULL) {
         printf(",");
     }
     printf("\n");
@@ -115,11 +120,13 @@ prv_print_token(lwjson_token_print_t* prt, const lwjson_token_t* token) {
  * \note            This function is not re-entrant
  * \param[in]       token: Token to print
  */
+#if !LWJSON_CFG_COMPACT_TOKEN
 void
 lwjson_print_token(const lwjson_token_t* token) {
     lwjson_token_print_t prt = {0};
-    prv_print_token(&prt, token);
+    prv_print_token(&prt, NULL, token);
 }
+#endif /* !LWJSON_CFG_COMPACT_TOKEN */
 
 /**
  * \brief           Prints and outputs full parsed LwJSON instance
@@ -129,5 +136,5 @@ lwjson_print_token(const lwjson_token_t* token) {
 void
 lwjson_print_json(const lwjson_t* lwobj) {
     lwjson_token_print_t prt = {0};
-    prv_print_token(&prt, lwjson_get_first_token(lwobj));
+    prv_print_token(&prt, lwobj, lwjson_get_first_token(lwobj));
 }
@@ -0,0 +1,169 @@
+/**
+ * \file            lwjson_file.c
+ * \brief           Parsing of files mapped to memory
+ */
+
+/*
+ * Copyright (c) 2024 Tilen MAJERLE
+ *
+ * Permission is hereby granted, free of charge, to any person
+ * obtaining a copy of this software and associated documentation
+ * files (the "Software"), to deal in the Software without restriction,
+ * including without limitation the rights to use, copy, modify, merge,
+ * publish, distribute, sublicense, and/or sell copies of the Software,
+ * and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be
+ * included in all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND,
+ * EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES
+ * OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE
+ * AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT
+ * HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY,
+ * WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR
+ * OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * This file is part of LwJSON - Lightweight JSON format parser.
+ *
+ * Author:          Tilen MAJERLE <tilen@majerle.eu>
+ * Version:         v1.7.0
+ */
+#if !defined(_POSIX_C_SOURCE) && !defined(_WIN32)
+#define _POSIX_C_SOURCE 200809L
+#endif /* !defined(_POSIX_C_SOURCE) && !defined(_WIN32) */
+#include "lwjson/lwjson.h"
+
+#if LWJSON_CFG_FILE
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * \brief           Map file read-only to memory
+ *
+ * Kernel is advised that data are read sequentially and will be needed soon,
+ * so that pages are read ahead while they are being parsed.
+ *
+ * \param[in]       path: Path to the file
+ * \param[out]      data: Pointer to pointer to mapped data
+ * \param[out]      len: Length of mapped data in units of bytes
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_file_map(const char* path, const void** data, size_t* len) {
+    struct stat st;
+    void* map;
+    int fd;
+
+    if (path == NULL || data == NULL || len == NULL) {
+        return lwjsonERRPAR;
+    }
+    fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return lwjsonERR;
+    }
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        close(fd);
+        return lwjsonERR;
+    }
+    if (st.st_size == 0) {
+        close(fd);
+        return lwjsonERRJSON; /* Empty file is not valid JSON */
+    }
+    map = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); /* Mapping stays valid after file is closed */
+    if (map == MAP_FAILED) {
+        return lwjsonERRMEM;
+    }
+    posix_madvise(map, (size_t)st.st_size, POSIX_MADV_SEQUENTIAL);
+    posix_madvise(map, (size_t)st.st_size, POSIX_MADV_WILLNEED);
+    *data = map;
+    *len = (size_t)st.st_size;
+    return lwjsonOK;
+}
+
+/**
+ * \brief           Unmap file mapped with \ref lwjson_file_map
+ * \param[in]       data: Pointer to mapped data
+ * \param[in]       len: Length of mapped data in units of bytes
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_file_unmap(const void* data, size_t len) {
+    if (data == NULL) {
+        return lwjsonERRPAR;
+    }
+    return munmap((void*)data, len) == 0 ? lwjsonOK : lwjsonERR;
+}
+
+/**
+ * \brief           Parse JSON file, mapped to memory
+ *
+ * File is not copied, tokens refer directly to the mapped data.
+ * It stays mapped until \ref lwjson_free is called, or next file is parsed with the same instance.
+ *
+ * \param[in,out]   lwobj: LwJSON instance
+ * \param[in]       path: Path to the file
+ * \return          \ref lwjsonOK on success, member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_parse_file(lwjson_t* lwobj, const char* path) {
+    lwjsonr_t res;
+
+    if (lwobj == NULL || path == NULL) {
+        return lwjsonERRPAR;
+    }
+
+    /* Unmap previous file, its tokens are no longer valid */
+    lwjson_free(lwobj);
+    res = lwjson_file_map(path, &lwobj->file_data, &lwobj->file_len);
+    if (res != lwjsonOK) {
+        return res;
+    }
+    res = lwjson_parse_ex(lwobj, lwobj->file_data, lwobj->file_len);
+    if (res != lwjsonOK) {
+        lwjson_free(lwobj);
+    }
+    return res;
+}
+
+/**
+ * \brief           Parse JSON file, mapped to memory, in streaming mode
+ *
+ * Characters are passed to \ref lwjson_stream_parse one by one, until stream is done or error is detected.
+ * File is unmapped before function returns.
+ *
+ * \param[in,out]   jsp: Stream JSON structure
+ * \param[in]       path: Path to the file
+ * \return          \ref lwjsonSTREAMDONE when valid JSON was parsed,
+ *                  \ref lwjsonSTREAMINPROG or \ref lwjsonSTREAMWAITFIRSTCHAR when file ended before it,
+ *                  member of \ref lwjsonr_t otherwise
+ */
+lwjsonr_t
+lwjson_stream_parse_file(lwjson_stream_parser_t* jsp, const char* path) {
+    lwjsonr_t res;
+    const void* data;
+    size_t len;
+
+    if (jsp == NULL || path == NULL) {
+        return lwjsonERRPAR;
+    }
+    res = lwjson_file_map(path, &data, &len);
+    if (res != lwjsonOK) {
+        return res;
+    }
+    for (size_t i = 0; i < len; ++i) {
+        res = lwjson_stream_parse(jsp, ((const char*)data)[i]);
+        if (res != lwjsonSTREAMINPROG && res != lwjsonSTREAMWAITFIRSTCHAR) {
+            break;
+        }
+    }
+    lwjson_file_unmap(data, len);
+    return res;
+}
+
+#endif /* LWJSON_CFG_FILE */
@@ -133,6 +133,58 @@ prv_stack_get_top(lwjson_stream_parser_t* jsp) {
     return LWJSON_STREAM_TYPE_NONE;
 }
 
+#if LWJSON_CFG_VALIDATE_UTF8
+
+/**
+ * \brief           Check next byte of string for well-formed UTF-8
+ *
+ * Leading byte sets number of continuation bytes to follow and valid range of the first one,
+ * which excludes overlong forms, surrogates and code points above `U+10FFFF`.
+ *
+ * \param           jsp: JSON stream parser instance
+ * \param           c: Byte of the string
+ * \return          `1` if byte is valid at current position, `0` otherwise
+ */
+static uint8_t
+prv_utf8_next(lwjson_stream_parser_t* jsp, uint8_t c) {
+    if (jsp->data.str.utf8_cont > 0) {
+        if (c < jsp->data.str.utf8_lo || c > jsp->data.str.utf8_hi) {
+            return 0;
+        }
+        --jsp->data.str.utf8_cont;
+        jsp->data.str.utf8_lo = 0x80;
+        jsp->data.str.utf8_hi = 0xBF;
+        return 1;
+    }
+    if (c < 0x80) {
+        return 1;
+    }
+    jsp->data.str.utf8_lo = 0x80;
+    jsp->data.str.utf8_hi = 0xBF;
+    if (c >= 0xC2 && c <= 0xDF) {
+        jsp->data.str.utf8_cont = 1;
+    } else if (c >= 0xE0 && c <= 0xEF) {
+        jsp->data.str.utf8_cont = 2;
+        if (c == 0xE0) {
+            jsp->data.str.utf8_lo = 0xA0;
+        } else if (c == 0xED) {
+            jsp->data.str.utf8_hi = 0x9F;
+        }
+    } else if (c >= 0xF0 && c <= 0xF4) {
+        jsp->data.str.utf8_cont = 3;
+        if (c == 0xF0) {
+            jsp->data.str.utf8_lo = 0x90;
+        } else if (c == 0xF4) {
+            jsp->data.str.utf8_hi = 0x8F;
+        }
+    } else {
+        return 0;
+    }
+    return 1;
+}
+
+#endif /* LWJSON_CFG_VALIDATE_UTF8 */
+
 /**
  * \brief           Initialize LwJSON stream object before parsing takes place
  * \param[in,out]   jsp: Stream JSON structure 
@@ -354,6 +406,14 @@ start_over:
         case LWJSON_STREAM_STATE_PARSING_STRING: {
             lwjson_stream_type_t type = prv_stack_get_top(jsp);
 
+#if LWJSON_CFG_VALIDATE_UTF8
+            /* Closing quote is not valid in the middle of sequence either */
+            if (!prv_utf8_next(jsp, (uint8_t)chr)) {
+                LWJSON_DEBUG(jsp, "ERROR - string is not valid UTF-8\r\n");
+                return lwjsonERRJSON;
+            }
+#endif /* LWJSON_CFG_VALIDATE_UTF8 */
+
             /* 
              * Quote character may trigger end of string, 
              * or if backslasled before - it is part of string
@@ -1,4 +1,5 @@
 #include <stdio.h>
+#include <stdlib.h>
 #include "lwjson/lwjson.h"
 
 /**
@@ -12,6 +13,12 @@ typedef struct {
 /* LwJSON instance and tokens */
 static lwjson_token_t tokens[4096];
 static lwjson_t lwjson;
+#if LWJSON_CFG_CHILD_INDEX
+static lwjson_token_t* tokens_index[4096];
+#endif /* LWJSON_CFG_CHILD_INDEX */
+#if LWJSON_CFG_KEY_INDEX
+static lwjson_token_t* tokens_key_index[4096];
+#endif /* LWJSON_CFG_KEY_INDEX */
 
 /* Test JSON parsing */
 static void
@@ -92,6 +99,56 @@ test_json_parse(void) {
     RUN_TEST(lwjsonERRJSON, "{\"k\":\"\\u123\"}");
     RUN_TEST(lwjsonERRJSON, "{\"k\":\"\\a\"}");
 
+    /* Long strings and blank runs, spanning over several 64-byte blocks */
+    RUN_TEST(lwjsonOK, "{\"k\":\"0123456789012345678901234567890123456789012345678901234567890123456789\\\"0123456789"
+                       "012345678901234567890123456789012345678901234567890123\\u12ab89\"}");
+    RUN_TEST(lwjsonOK, "{                                                                                 \"k\""
+                       "                                                                                  :"
+                       "\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t"
+                       "\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t\t1"
+                       "\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n"
+                       "\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n\r\n}");
+    RUN_TEST(lwjsonERRJSON, "{\"k\":\"0123456789012345678901234567890123456789012345678901234567890123456789"
+                            "0123456789012345678901234567890123456789012345678901234567890123456789}");
+    RUN_TEST(lwjsonERRJSON, "{\"k\":\"0123456789012345678901234567890123456789012345678901234567890123456789"
+                            "0123456789012345678901234567890123456789012345678901234567890123456789\\a\"}");
+
+#if LWJSON_CFG_VALIDATE_UTF8
+    /* Strings must be well-formed UTF-8 */
+    RUN_TEST(lwjsonOK, "{\"k\xC3\xA9\":\"\xE2\x82\xAC \xF0\x9F\x98\x80 \xF4\x8F\xBF\xBF\"}");
+    RUN_TEST(lwjsonOK, "{\"k\":\"0123456789012345678901234567890\xC3\xA9" "0123456789012345678901234567890123456789"
+                       "\xE2\x82\xAC" "0123456789012345678901234567890123456789\xF0\x9F\x98\x80\"}");
+    RUN_TEST(lwjsonERRJSON, "{\"k\":\"\xC3\"}");             /* Truncated sequence */
+    RUN_TEST(lwjsonERRJSON, "{\"k\":\"\xC0\xAF\"}");         /* Overlong form */
+    RUN_TEST(lwjsonERRJSON, "{\"k\":\"\xED\xA0\x80\"}");     /* Surrogate */
+    RUN_TEST(lwjsonERRJSON, "{\"k\":\"\xF4\x90\x80\x80\"}"); /* Above U+10FFFF */
+    RUN_TEST(lwjsonERRJSON, "{\"k\xFF\":1}");                /* Invalid byte in property name */
+    RUN_TEST(lwjsonERRJSON, "{\"k\":\"0123456789012345678901234567890\xE2\x82"
+                            "0123456789012345678901234567890123456789\xC3\xA9\"}");
+
+    /* Long non-ASCII strings, with sequences crossing 32-byte boundaries */
+#define TEST_U8_2B "\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9\xC3\xA9"
+#define TEST_U8_3B "\xE2\x82\xAC\xE2\x82\xAC\xE2\x82\xAC\xE2\x82\xAC\xE2\x82\xAC\xE2\x82\xAC\xE2\x82\xAC"
+#define TEST_U8_4B "\xF0\x9F\x98\x80\xF0\x9F\x98\x80\xF0\x9F\x98\x80\xF0\x9F\x98\x80\xF0\x9F\x98\x80"
+#define TEST_U8_A  "0123456789012345678901234567890123456789"
+    RUN_TEST(lwjsonOK, "{\"k\":\"" TEST_U8_2B TEST_U8_2B TEST_U8_2B TEST_U8_2B "\"}");
+    RUN_TEST(lwjsonOK, "{\"k\":\"" TEST_U8_3B "x" TEST_U8_3B "xy" TEST_U8_3B TEST_U8_4B "x" TEST_U8_4B "\"}");
+    RUN_TEST(lwjsonOK, "{\"k" TEST_U8_4B TEST_U8_3B TEST_U8_2B TEST_U8_A "\":[\"" TEST_U8_A TEST_U8_4B TEST_U8_A "\"]}");
+    RUN_TEST(lwjsonERRJSON, "{\"k\":\"" TEST_U8_2B TEST_U8_A "\xE0\x80\xAF" TEST_U8_A "\"}");     /* Overlong form */
+    RUN_TEST(lwjsonERRJSON, "{\"k\":\"" TEST_U8_2B TEST_U8_A "\xC1\xBF" TEST_U8_A "\"}");         /* Overlong form */
+    RUN_TEST(lwjsonERRJSON, "{\"k\":\"" TEST_U8_3B TEST_U8_A "\xED\xBF\xBF" TEST_U8_A "\"}");     /* Surrogate */
+    RUN_TEST(lwjsonERRJSON, "{\"k\":\"" TEST_U8_4B TEST_U8_A "\xF4\x90\x80\x80" TEST_U8_A "\"}"); /* Above U+10FFFF */
+    RUN_TEST(lwjsonERRJSON, "{\"k\":\"" TEST_U8_2B TEST_U8_A "\xA9" TEST_U8_A "\"}");              /* Lone continuation */
+    RUN_TEST(lwjsonERRJSON, "{\"k\":\"" TEST_U8_2B TEST_U8_A "\xE2\x82\xAC\xAC" TEST_U8_A "\"}"); /* Too long */
+    RUN_TEST(lwjsonERRJSON, "{\"k\":\"" TEST_U8_2B "0123456789\xF0\x9F" TEST_U8_A "\"}");        /* Truncated */
+    RUN_TEST(lwjsonERRJSON, "{\"k\":\"" TEST_U8_2B TEST_U8_A "\xF0\x9F\x98\"}");               /* Truncated at end */
+    RUN_TEST(lwjsonERRJSON, "{\"k\":\"" TEST_U8_4B TEST_U8_4B TEST_U8_A "\xFF\"}");              /* Invalid byte */
+#undef TEST_U8_2B
+#undef TEST_U8_3B
+#undef TEST_U8_4B
+#undef TEST_U8_A
+#endif /* LWJSON_CFG_VALIDATE_UTF8 */
+
     /* Run JSON tests to fail */
     RUN_TEST(lwjsonERRPAR, "");
     RUN_TEST(lwjsonERRJSON, "{[]}");          /* Array without key inside object */
@@ -126,13 +183,14 @@ test_parse_token_count(void) {
 #define RUN_TEST(exp_token_count, json_str)                                                                            \
     do {                                                                                                               \
         if (lwjson_parse(&lwjson, (json_str)) == lwjsonOK) {                                                           \
-            if ((lwjson.next_free_token_pos + 1) == exp_token_count) {                                                 \
+            if (lwjson_get_tokens_used(&lwjson) == exp_token_count                                                     \
+                && lwjson_count_tokens((json_str), strlen(json_str)) == lwjson.next_free_token_pos) {                  \
                 ++test_passed;                                                                                         \
             } else {                                                                                                   \
                 ++test_failed;                                                                                         \
                 printf("Test failed for JSON token count on input %s\r\n", (json_str));                                \
             }                                                                                                          \
-            lwjson_free(&lwjson);                                                                                      \
+            lwjson_reset(&lwjson);                                                                                     \
         } else {                                                                                                       \
             ++test_failed;                                                                                             \
             printf("Test failed for JSON parse on input %s\r\n", (json_str));                                          \
@@ -149,6 +207,9 @@ test_parse_token_count(void) {
     RUN_TEST(4, "{\"k\":{\"k\":{\"k\":[]}}}");
     RUN_TEST(6, "{\"k\":{\"k\":{\"k\":[[[]]]}}}");
     RUN_TEST(6, "{\"k\":[{\"k\":1},{\"k\":2}]}");
+    RUN_TEST(1, "[]");
+    RUN_TEST(5, " [ \"a,b\" , \"c:[\\\"d\" , {} , true ]  ");
+    RUN_TEST(8, "{\"a\" : -1.5e3, \"b\":[null,false,{\"c\":\"}\"}],\"d\":{}}");
 
 #undef RUN_TEST
 
@@ -289,11 +350,115 @@ test_json_data_types(void) {
     printf("Data type test result pass/fail: %d/%d\r\n\r\n", (int)test_passed, (int)test_failed);
 }
 
+/* Test number values */
+static void
+test_json_number_values(void) {
+    size_t test_failed = 0, test_passed = 0;
+    const lwjson_token_t* t;
+
+    printf("---\r\nTest JSON number values..\r\n");
+
+#if LWJSON_CFG_REAL_EXACT
+#define REAL_EQUAL(val, exp) ((val) == (exp))
+#else
+#define REAL_EQUAL(val, exp)                                                                                           \
+    ((val) - (exp) <= ((exp) < 0 ? -(exp) : (exp)) * (sizeof(lwjson_real_t) == sizeof(float) ? 1e-6 : 1e-14)         \
+     && (exp) - (val) <= ((exp) < 0 ? -(exp) : (exp)) * (sizeof(lwjson_real_t) == sizeof(float) ? 1e-6 : 1e-14))
+#endif /* LWJSON_CFG_REAL_EXACT */
+
+#define RUN_TEST(num_str)                                                                                              \
+    do {                                                                                                               \
+        lwjson_real_t exp_val = sizeof(lwjson_real_t) == sizeof(float) ? (lwjson_real_t)strtof((num_str), NULL)       \
+                                                                        : (lwjson_real_t)strtod((num_str), NULL);      \
+        if (lwjson_parse(&lwjson, "[" num_str "]") == lwjsonOK && (t = lwjson_find(&lwjson, "#0")) != NULL            \
+            && t->type == LWJSON_TYPE_NUM_REAL && REAL_EQUAL(lwjson_get_val_real(t), exp_val)) {                       \
+            ++test_passed;                                                                                             \
+        } else {                                                                                                       \
+            ++test_failed;                                                                                             \
+            printf("Test failed for real number %s on line %d\r\n", (num_str), __LINE__);                              \
+        }                                                                                                              \
+    } while (0)
+
+    RUN_TEST("1.5");
+    RUN_TEST("-0.125e2");
+    RUN_TEST("123.456");
+    RUN_TEST("0.1");
+    RUN_TEST("1e-5");
+    RUN_TEST("-1E+5");
+    RUN_TEST("0.30000000000000004");
+    RUN_TEST("9007199254740993.0");
+    RUN_TEST("3.4028234e38");
+    RUN_TEST("1.17549435e-38");
+    RUN_TEST("1.00000000000000011102230246251565404236316680908203125");
+    RUN_TEST("123456789012345678901234567890.5");
+    RUN_TEST("0.000000000000000000000000000000000000000000001e40");
+    RUN_TEST("7.2057594037927933e16");
+    RUN_TEST("2.2250738585072014e-308");
+
+#undef RUN_TEST
+#undef REAL_EQUAL
+
+#define RUN_TEST(exp_res, num_str)                                                                                     \
+    do {                                                                                                               \
+        lwjsonr_t res = lwjson_parse(&lwjson, "[" num_str "]");                                                        \
+        if (res == (exp_res)                                                                                           \
+            && (res != lwjsonOK                                                                                        \
+                || ((t = lwjson_find(&lwjson, "#0")) != NULL && t->type == LWJSON_TYPE_NUM_INT                         \
+                    && lwjson_get_val_int(t) == (lwjson_int_t)strtoll((num_str), NULL, 10)))) {                        \
+            ++test_passed;                                                                                             \
+        } else {                                                                                                       \
+            ++test_failed;                                                                                             \
+            printf("Test failed for int number %s on line %d\r\n", (num_str), __LINE__);                               \
+        }                                                                                                              \
+    } while (0)
+
+    RUN_TEST(lwjsonOK, "0");
+    RUN_TEST(lwjsonOK, "-1234");
+    RUN_TEST(lwjsonOK, "123456789");
+    RUN_TEST(lwjsonOK, "-2147483648");
+    RUN_TEST(lwjsonERRNUMRANGE, "123456789012345678901");
+    RUN_TEST(lwjsonERRNUMRANGE, "-100000000000000000000");
+    if (sizeof(lwjson_int_t) >= sizeof(long long)) {
+        RUN_TEST(lwjsonOK, "1712345678901");
+        RUN_TEST(lwjsonOK, "-1234567890123456789");
+        RUN_TEST(lwjsonOK, "9223372036854775807");
+        RUN_TEST(lwjsonOK, "-9223372036854775808");
+        RUN_TEST(lwjsonERRNUMRANGE, "9223372036854775808");
+        RUN_TEST(lwjsonERRNUMRANGE, "-9223372036854775809");
+    }
+
+#undef RUN_TEST
+
+#if LWJSON_CFG_LAZY_NUMBER
+    /* Number text is kept in token and converted on access */
+    if (lwjson_parse(&lwjson, "{\"a\": -12.5e1 ,\"b\":[7 ]}") == lwjsonOK
+        && (t = lwjson_find(&lwjson, "a")) != NULL && t->type == LWJSON_TYPE_NUM_REAL
+        && t->u.str.token_value_len == 7 && strncmp(t->u.str.token_value, "-12.5e1", 7) == 0
+        && lwjson_get_val_real(t) == (lwjson_real_t)-125 && lwjson_get_val_int(t) == 0
+        && (t = lwjson_find(&lwjson, "b.#0")) != NULL && t->u.str.token_value_len == 1 && lwjson_get_val_int(t) == 7) {
+        ++test_passed;
+    } else {
+        ++test_failed;
+        printf("Test failed for lazy number conversion on line %d\r\n", __LINE__);
+    }
+#endif /* LWJSON_CFG_LAZY_NUMBER */
+
+    /* Print results */
+    printf("Number test result pass/fail: %d/%d\r\n\r\n", (int)test_passed, (int)test_failed);
+}
+
 /* Test find function */
 static void
 test_find_function(void) {
-    size_t test_failed = 0, test_passed = 0;
+    size_t test_failed = 0, test_passed = 0, n = 0, len;
     const lwjson_token_t* token;
+    char keys_str[1024], buf[32];
+    const char* str;
+    const char* decoded = "a\n\"b\\/\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80\xEF\xBF\xBDx";
+    lwjson_path_t path, paths[7];
+    const lwjson_token_t* results[7];
+    const char* many_paths[] = {"my_arr.#0.num",   "my_arr.#2.str", "my_arr.#.str", "my_obj.arr.#.#.my_key",
+                                "my_obj.key_true", "my_arr.#3.#1",  "my_obj.nokey"};
     const char* json_str = "\
     {\
         \"my_arr\":[\
@@ -341,16 +506,16 @@ test_find_function(void) {
     RUN_TEST((token = lwjson_find(&lwjson, "my_arr.#1")) != NULL && token->type == LWJSON_TYPE_OBJECT);
     RUN_TEST((token = lwjson_find(&lwjson, "my_arr.#2")) != NULL && token->type == LWJSON_TYPE_OBJECT);
     RUN_TEST((token = lwjson_find(&lwjson, "my_arr.#0.str")) != NULL && token->type == LWJSON_TYPE_STRING
-             && strncmp(token->u.str.token_value, "first_entry", 11) == 0);
+             && strncmp(lwjson_get_val_string_ex(&lwjson, token, NULL), "first_entry", 11) == 0);
     RUN_TEST((token = lwjson_find(&lwjson, "my_arr.#1.str")) != NULL && token->type == LWJSON_TYPE_STRING
-             && strncmp(token->u.str.token_value, "second_entry", 12) == 0);
+             && strncmp(lwjson_get_val_string_ex(&lwjson, token, NULL), "second_entry", 12) == 0);
     RUN_TEST((token = lwjson_find(&lwjson, "my_arr.#2.str")) != NULL && token->type == LWJSON_TYPE_STRING
-             && strncmp(token->u.str.token_value, "third_entry", 11) == 0);
+             && strncmp(lwjson_get_val_string_ex(&lwjson, token, NULL), "third_entry", 11) == 0);
     RUN_TEST((token = lwjson_find(&lwjson, "my_arr.#3")) != NULL && token->type == LWJSON_TYPE_ARRAY);
     RUN_TEST((token = lwjson_find(&lwjson, "my_arr.#3.#1")) != NULL && token->type == LWJSON_TYPE_STRING
-             && strncmp(token->u.str.token_value, "def", 3) == 0);
+             && strncmp(lwjson_get_val_string_ex(&lwjson, token, NULL), "def", 3) == 0);
     RUN_TEST((token = lwjson_find(&lwjson, "my_arr.#3.#0")) != NULL && token->type == LWJSON_TYPE_STRING
-             && strncmp(token->u.str.token_value, "abc", 3) == 0);
+             && strncmp(lwjson_get_val_string_ex(&lwjson, token, NULL), "abc", 3) == 0);
     RUN_TEST((token = lwjson_find(&lwjson, "my_arr.#3.#")) == NULL);
 
     /* Use EX version to search for tokens */
@@ -363,11 +528,13 @@ test_find_function(void) {
 
     /* Search for first match in any array */
     RUN_TEST((token = lwjson_find_ex(&lwjson, NULL, "my_obj.arr.#.#.my_key")) != NULL
-             && token->type == LWJSON_TYPE_STRING && strncmp(token->u.str.token_value, "my_text", 7) == 0);
+             && token->type == LWJSON_TYPE_STRING
+             && strncmp(lwjson_get_val_string_ex(&lwjson, token, NULL), "my_text", 7) == 0);
 
     /* Search for match in specific array keys */
     RUN_TEST((token = lwjson_find_ex(&lwjson, NULL, "my_obj.arr.#2.#0.my_key")) != NULL
-             && token->type == LWJSON_TYPE_STRING && strncmp(token->u.str.token_value, "my_text", 7) == 0);
+             && token->type == LWJSON_TYPE_STRING
+             && strncmp(lwjson_get_val_string_ex(&lwjson, token, NULL), "my_text", 7) == 0);
 
     /* Search for match in specific array keys = must return NULL, no index = 1 in second array */
     RUN_TEST((token = lwjson_find_ex(&lwjson, NULL, "my_obj.arr.#2.#1.my_key")) == NULL);
@@ -378,20 +545,154 @@ test_find_function(void) {
              && (token = lwjson_find_ex(&lwjson, token, "#2")) != NULL
              && (token = lwjson_find_ex(&lwjson, token, "#0")) != NULL
              && (token = lwjson_find_ex(&lwjson, token, "my_key")) != NULL && token->type == LWJSON_TYPE_STRING
-             && strncmp(token->u.str.token_value, "my_text", 7) == 0);
+             && strncmp(lwjson_get_val_string_ex(&lwjson, token, NULL), "my_text", 7) == 0);
 
     /* Search for match in specific array keys and check for string length field */
     RUN_TEST((token = lwjson_find_ex(&lwjson, NULL, "my_obj.ustr")) != NULL && token->type == LWJSON_TYPE_STRING
              && lwjson_get_val_string_length(token) == 11
-             && strncmp(token->u.str.token_value, "\\t\\u1234abc", 11) == 0);
+             && strncmp(lwjson_get_val_string_ex(&lwjson, token, NULL), "\\t\\u1234abc", 11) == 0);
+
+    /* Check escape sequence indication */
+    RUN_TEST((token = lwjson_find_ex(&lwjson, NULL, "my_obj.ustr")) != NULL && lwjson_get_val_string_escaped(token));
+    RUN_TEST((token = lwjson_find_ex(&lwjson, NULL, "my_arr.#0.str")) != NULL && !lwjson_get_val_string_escaped(token));
 
     /* Check string compare */
+#if !LWJSON_CFG_COMPACT_TOKEN
     RUN_TEST((token = lwjson_find_ex(&lwjson, NULL, "my_obj.arr.#.#.my_key")) != NULL
              && lwjson_string_compare(token, "my_text"));
     RUN_TEST((token = lwjson_find_ex(&lwjson, NULL, "my_obj.arr.#.#.my_key")) != NULL
              && lwjson_string_compare_n(token, "my_text", 3));
     RUN_TEST((token = lwjson_find_ex(&lwjson, NULL, "my_obj.arr.#.#.my_key")) != NULL
              && !lwjson_string_compare_n(token, "my_stext", 4)); /* Must be a fail */
+#endif /* !LWJSON_CFG_COMPACT_TOKEN */
+    RUN_TEST((token = lwjson_find_ex(&lwjson, NULL, "my_obj.arr.#.#.my_key")) != NULL
+             && lwjson_string_compare_ex(&lwjson, token, "my_text"));
+    RUN_TEST((token = lwjson_find_ex(&lwjson, NULL, "my_obj.arr.#.#.my_key")) != NULL
+             && !lwjson_string_compare_n_ex(&lwjson, token, "my_stext", 4)); /* Must be a fail */
+
+    /* Check token names and links */
+    RUN_TEST((token = lwjson_find_ex(&lwjson, NULL, "my_obj.ustr")) != NULL
+             && strncmp(lwjson_get_name(&lwjson, token, NULL), "ustr", 4) == 0 && lwjson_get_next(token) == NULL);
+    RUN_TEST((token = lwjson_find_ex(&lwjson, NULL, "my_arr")) != NULL
+             && (token = lwjson_get_next(token)) != NULL && lwjson_get_name(&lwjson, token, NULL) != NULL
+             && strncmp(lwjson_get_name(&lwjson, token, NULL), "my_obj", 6) == 0);
+    RUN_TEST((token = lwjson_find_ex(&lwjson, NULL, "my_arr.#0")) != NULL
+             && lwjson_get_name(&lwjson, token, NULL) == NULL);
+
+    /* Index out of range of size_t must not wrap around to the first element */
+    RUN_TEST(lwjson_find_ex(&lwjson, NULL, "my_arr.#18446744073709551616") == NULL);
+
+    /* JSON pointer */
+    RUN_TEST((token = lwjson_find_pointer(&lwjson, NULL, "")) == lwjson_get_first_token(&lwjson));
+    RUN_TEST((token = lwjson_find_pointer(&lwjson, NULL, "/my_arr/2/str")) != NULL
+             && strncmp(lwjson_get_val_string_ex(&lwjson, token, NULL), "third_entry", 11) == 0);
+    RUN_TEST((token = lwjson_find_pointer(&lwjson, NULL, "/my_obj/arr/2/0/my_key")) != NULL
+             && token->type == LWJSON_TYPE_STRING);
+    RUN_TEST((token = lwjson_find_pointer(&lwjson, NULL, "/my_obj/key_true")) != NULL
+             && token->type == LWJSON_TYPE_TRUE);
+    RUN_TEST((token = lwjson_find_pointer(&lwjson, NULL, "/my_arr/-")) == NULL);
+    RUN_TEST((token = lwjson_find_pointer(&lwjson, NULL, "/my_arr/01")) == NULL);
+    RUN_TEST((token = lwjson_find_pointer(&lwjson, NULL, "/my_arr/6")) == NULL);
+    RUN_TEST((token = lwjson_find_pointer(&lwjson, NULL, "/my_arr/18446744073709551616")) == NULL);
+    RUN_TEST((token = lwjson_find_pointer(&lwjson, NULL, "/my_arr/0/num/x")) == NULL);
+    RUN_TEST((token = lwjson_find_pointer(&lwjson, NULL, "my_arr")) == NULL);
+    RUN_TEST(lwjson_parse(&lwjson, "{\"a/b\":1,\"m~n\":[2],\"\":3,\"~\":4}") == lwjsonOK);
+    RUN_TEST((token = lwjson_find_pointer(&lwjson, NULL, "/a~1b")) != NULL && lwjson_get_val_int(token) == 1);
+    RUN_TEST((token = lwjson_find_pointer(&lwjson, NULL, "/m~0n/0")) != NULL && lwjson_get_val_int(token) == 2);
+    RUN_TEST((token = lwjson_find_pointer(&lwjson, NULL, "/")) != NULL && lwjson_get_val_int(token) == 3);
+    RUN_TEST((token = lwjson_find_pointer(&lwjson, NULL, "/~0")) != NULL && lwjson_get_val_int(token) == 4);
+    RUN_TEST((token = lwjson_find_pointer(&lwjson, NULL, "/a/b")) == NULL);
+    RUN_TEST((token = lwjson_find_pointer(&lwjson, NULL, "/~2")) == NULL);
+    RUN_TEST((token = lwjson_find_pointer(&lwjson, lwjson_find(&lwjson, "m~n"), "/0")) != NULL
+             && lwjson_get_val_int(token) == 2);
+
+    /* Decoded string values */
+    RUN_TEST(lwjson_parse(&lwjson, "{\"e\":\"a\\n\\\"b\\\\\\/\\u00e9\\u20ac\\ud83d\\ude00\\ud800x\",\"p\":\"plain\"}")
+             == lwjsonOK);
+    RUN_TEST((token = lwjson_find(&lwjson, "p")) != NULL
+             && lwjson_get_val_string_decoded(&lwjson, token, NULL, 0, &len)
+                    == lwjson_get_val_string_ex(&lwjson, token, NULL)
+             && len == 5);
+    RUN_TEST((token = lwjson_find(&lwjson, "e")) != NULL
+             && (str = lwjson_get_val_string_decoded(&lwjson, token, buf, sizeof(buf), &len)) == buf && len == 19
+             && memcmp(str, decoded, len) == 0);
+    RUN_TEST(lwjson_get_val_string_decoded(&lwjson, token, buf, 18, &len) == NULL);
+    RUN_TEST(lwjson_string_compare_decoded(&lwjson, token, decoded, 19));
+    RUN_TEST(!lwjson_string_compare_decoded(&lwjson, token, decoded, 18));
+    memcpy(buf, decoded, 19);
+    buf[18] = 'y';
+    RUN_TEST(!lwjson_string_compare_decoded(&lwjson, token, buf, 19));
+    RUN_TEST(lwjson_string_compare_decoded(&lwjson, lwjson_find(&lwjson, "p"), "plain", 5));
+    RUN_TEST(!lwjson_string_compare_decoded(&lwjson, lwjson_find(&lwjson, "p"), "plai", 4));
+    RUN_TEST(lwjson_get_val_string_decoded(&lwjson, lwjson_get_first_token(&lwjson), buf, sizeof(buf), &len) == NULL);
+
+    /* Index access in long arrays, with nested arrays in between */
+    RUN_TEST(lwjson_parse(&lwjson, "{\"a\":[0,1,2,3,[4,5,6,7,8,9,10,11,12],5,6,7,8,9,10,11],\"b\":{\"c\":1,\"d\":2}}")
+             == lwjsonOK);
+    RUN_TEST((token = lwjson_find(&lwjson, "a.#0")) != NULL && lwjson_get_val_int(token) == 0);
+    RUN_TEST((token = lwjson_find(&lwjson, "a.#4.#8")) != NULL && lwjson_get_val_int(token) == 12);
+    RUN_TEST((token = lwjson_find(&lwjson, "a.#5")) != NULL && lwjson_get_val_int(token) == 5);
+    RUN_TEST((token = lwjson_find(&lwjson, "a.#11")) != NULL && lwjson_get_val_int(token) == 11);
+    RUN_TEST((token = lwjson_find(&lwjson, "a.#12")) == NULL);
+    RUN_TEST((token = lwjson_find(&lwjson, "b.d")) != NULL && lwjson_get_val_int(token) == 2);
+#if LWJSON_CFG_CHILD_INDEX
+    RUN_TEST((token = lwjson_find(&lwjson, "a")) != NULL && lwjson_get_child_count(token) == 12
+             && token->child_index != NULL);
+    RUN_TEST((token = lwjson_find(&lwjson, "b")) != NULL && lwjson_get_child_count(token) == 2);
+#endif /* LWJSON_CFG_CHILD_INDEX */
+
+    /* Key lookup in large objects, with duplicate keys found in object order */
+    n += (size_t)sprintf(&keys_str[n], "{\"k5\":-1");
+    for (size_t i = 0; i < 40; ++i) {
+        n += (size_t)sprintf(&keys_str[n], ",\"k%d\":%d", (int)i, (int)i);
+    }
+    sprintf(&keys_str[n], ",\"k5\":{\"x\":1},\"s\":{\"a\":1,\"b\":2}}");
+    RUN_TEST(lwjson_parse(&lwjson, keys_str) == lwjsonOK);
+    RUN_TEST((token = lwjson_find(&lwjson, "k0")) != NULL && lwjson_get_val_int(token) == 0);
+    RUN_TEST((token = lwjson_find(&lwjson, "k39")) != NULL && lwjson_get_val_int(token) == 39);
+    RUN_TEST((token = lwjson_find(&lwjson, "k5")) != NULL && lwjson_get_val_int(token) == -1);
+    RUN_TEST((token = lwjson_find(&lwjson, "k5.x")) != NULL && lwjson_get_val_int(token) == 1);
+    RUN_TEST((token = lwjson_find(&lwjson, "s.b")) != NULL && lwjson_get_val_int(token) == 2);
+    RUN_TEST(lwjson_find(&lwjson, "k40") == NULL && lwjson_find(&lwjson, "k") == NULL
+             && lwjson_find(&lwjson, "k5.y") == NULL);
+#if LWJSON_CFG_KEY_INDEX
+    RUN_TEST((token = lwjson_get_first_token(&lwjson)) != NULL && token->key_index != NULL
+             && token->key_index_len == 128);
+    RUN_TEST((token = lwjson_find(&lwjson, "s")) != NULL
+             && (token->key_index == NULL) == (2 < LWJSON_CFG_KEY_INDEX_MIN_CNT));
+#endif /* LWJSON_CFG_KEY_INDEX */
+
+    /* Compiled paths give the same results as the original paths */
+    RUN_TEST(lwjson_path_compile("k5.x", &path) == lwjsonOK && path.segments_cnt == 2
+             && (token = lwjson_find_compiled(&lwjson, NULL, &path)) != NULL && token == lwjson_find(&lwjson, "k5.x"));
+    RUN_TEST(lwjson_path_compile("k39", &path) == lwjsonOK
+             && (token = lwjson_find_compiled(&lwjson, NULL, &path)) != NULL && lwjson_get_val_int(token) == 39);
+    RUN_TEST(lwjson_path_compile("k5.y", &path) == lwjsonOK && lwjson_find_compiled(&lwjson, NULL, &path) == NULL);
+    RUN_TEST(lwjson_path_compile("#", &path) == lwjsonERRPAR && lwjson_path_compile("a.#", &path) == lwjsonERRPAR);
+    RUN_TEST(lwjson_path_compile("a.#1x", &path) == lwjsonERRPAR && lwjson_path_compile("a.", &path) == lwjsonERRPAR);
+    RUN_TEST(lwjson_path_compile("a.#18446744073709551616.b", &path) == lwjsonERRPAR);
+    RUN_TEST(lwjson_path_compile("a.b.c.d.e.f.g.h.i.j.k.l.m.n.o.p.q", &path) == lwjsonERRMEM);
+    RUN_TEST(lwjson_parse(&lwjson, json_str) == lwjsonOK);
+    RUN_TEST(lwjson_path_compile("my_arr.#1.str", &path) == lwjsonOK && path.segments_cnt == 3
+             && path.segments[1].type == LWJSON_PATH_INDEX && path.segments[1].index == 1
+             && (token = lwjson_find_compiled(&lwjson, NULL, &path)) != NULL
+             && token == lwjson_find(&lwjson, "my_arr.#1.str"));
+    RUN_TEST(lwjson_path_compile("my_obj.arr.#.#.my_key", &path) == lwjsonOK
+             && (token = lwjson_find_compiled(&lwjson, NULL, &path)) != NULL
+             && token == lwjson_find(&lwjson, "my_obj.arr.#.#.my_key"));
+    RUN_TEST(lwjson_path_compile("#1.str", &path) == lwjsonOK
+             && (token = lwjson_find_compiled(&lwjson, lwjson_find(&lwjson, "my_arr"), &path)) != NULL
+             && token == lwjson_find(&lwjson, "my_arr.#1.str"));
+
+    /* Multiple paths in single walk give the same results as separate searches */
+    for (size_t i = 0; i < LWJSON_ARRAYSIZE(many_paths); ++i) {
+        RUN_TEST(lwjson_path_compile(many_paths[i], &paths[i]) == lwjsonOK);
+    }
+    RUN_TEST(lwjson_find_many(&lwjson, paths, LWJSON_ARRAYSIZE(paths), results) == lwjsonOK);
+    for (size_t i = 0; i < LWJSON_ARRAYSIZE(many_paths); ++i) {
+        RUN_TEST(results[i] == lwjson_find(&lwjson, many_paths[i]));
+    }
+    RUN_TEST(results[0] != NULL && results[4] != NULL && results[4]->type == LWJSON_TYPE_TRUE && results[6] == NULL);
 
 #undef RUN_TEST
 
@@ -402,20 +703,939 @@ test_find_function(void) {
     printf("Find function test result pass/fail: %d/%d\r\n\r\n", (int)test_passed, (int)test_failed);
 }
 
+/**
+ * \brief           Document reported by \ref lwjson_parse_many
+ */
+typedef struct {
+    lwjsonr_t res; /*!< Parse result */
+    size_t offset; /*!< Document offset */
+    size_t len;    /*!< Document length */
+    size_t cnt;    /*!< Number of tokens */
+} test_doc_t;
+
+static test_doc_t test_docs[16];
+static size_t test_docs_cnt;
+
+/* Callback for parse many test */
+static void
+prv_parse_many_callback(lwjson_t* lw, lwjsonr_t res, size_t offset, size_t len, void* user_data) {
+    (void)user_data;
+    if (test_docs_cnt < LWJSON_ARRAYSIZE(test_docs)) {
+        test_docs[test_docs_cnt].res = res;
+        test_docs[test_docs_cnt].offset = offset;
+        test_docs[test_docs_cnt].len = len;
+        test_docs[test_docs_cnt].cnt = lw->flags.parsed ? lwjson_get_tokens_used(lw) : 0;
+    }
+    ++test_docs_cnt;
+}
+
+/* Test parsing of multiple documents */
+static void
+test_parse_many(void) {
+    size_t test_failed = 0, test_passed = 0, offset = 0, offsets[4];
+    const char* json_str = "{\"a\":1}\n[1, 2]\r\n{\"a\":tru}\n  {\"b\":[\"]\"]}{\"c\":2}\nx 1\n{\"d\":\n[]";
+    static const struct {
+        lwjsonr_t res;
+        const char* doc;
+        size_t cnt;
+    } exp[] = {
+        {lwjsonOK, "{\"a\":1}", 2},       {lwjsonOK, "[1, 2]", 3},        {lwjsonERRJSON, "{\"a\":tru}", 0},
+        {lwjsonOK, "{\"b\":[\"]\"]}", 3}, {lwjsonOK, "{\"c\":2}", 2},       {lwjsonERRJSON, "x 1\n", 0},
+        {lwjsonERRJSON, "{\"d\":\n", 0}, {lwjsonOK, "[]", 1},
+    };
+    static const char* truncated[] = {"[1]\n[12", "[1]\n[tru", "[1]\n[1.5e", "[1]\n{\"a\":-"};
+    char* buff;
+
+    printf("---\r\nTest JSON parse many..\r\n");
+
+#define RUN_TEST(c)                                                                                                    \
+    if ((c)) {                                                                                                         \
+        ++test_passed;                                                                                                 \
+    } else {                                                                                                           \
+        ++test_failed;                                                                                                 \
+        printf("Test failed on line %d\r\n", __LINE__);                                                                \
+    }
+
+    /* Valid documents are parsed, malformed are reported and skipped */
+    test_docs_cnt = 0;
+    RUN_TEST(lwjson_parse_many(&lwjson, json_str, strlen(json_str), prv_parse_many_callback, NULL) == lwjsonERR);
+    RUN_TEST(test_docs_cnt == LWJSON_ARRAYSIZE(exp));
+    for (size_t i = 0; i < LWJSON_ARRAYSIZE(exp) && i < test_docs_cnt; ++i) {
+        offset = (size_t)(strstr(&json_str[offset], exp[i].doc) - json_str);
+        RUN_TEST(test_docs[i].res == exp[i].res && test_docs[i].offset == offset
+                 && test_docs[i].len == strlen(exp[i].doc) && test_docs[i].cnt == exp[i].cnt);
+        offset += test_docs[i].len;
+    }
+
+    /* Chunks of whole lines, parsed separately */
+    json_str = "{\"a\":1}\n[1, 2, 3, 4, 5, 6, 7, 8, 9]\n{}\n[]\n{\"b\":\"\\n\"}\n[true]";
+    RUN_TEST(lwjson_split_many(json_str, strlen(json_str), offsets, LWJSON_ARRAYSIZE(offsets)) == lwjsonOK
+             && offsets[0] == 36 && offsets[1] == 36 && offsets[2] == 53 && offsets[3] == strlen(json_str));
+    test_docs_cnt = 0;
+    for (size_t i = 0, start = 0; i < LWJSON_ARRAYSIZE(offsets); start = offsets[i++]) {
+        RUN_TEST(lwjson_parse_many(&lwjson, &json_str[start], offsets[i] - start, prv_parse_many_callback, NULL)
+                 == lwjsonOK);
+    }
+    RUN_TEST(test_docs_cnt == 6);
+
+    /* Blanks only */
+    test_docs_cnt = 0;
+    RUN_TEST(lwjson_parse_many(&lwjson, " \r\n\n", 4, prv_parse_many_callback, NULL) == lwjsonOK
+             && test_docs_cnt == 0);
+
+    /* Last document ends in the middle of number or literal, nothing is read after the end of data */
+    for (size_t i = 0; i < LWJSON_ARRAYSIZE(truncated); ++i) {
+        size_t len = strlen(truncated[i]);
+
+        if ((buff = malloc(len)) == NULL) {
+            ++test_failed;
+            continue;
+        }
+        memcpy(buff, truncated[i], len);
+        test_docs_cnt = 0;
+        RUN_TEST(lwjson_parse_many(&lwjson, buff, len, prv_parse_many_callback, NULL) == lwjsonERR
+                 && test_docs_cnt == 2 && test_docs[0].res == lwjsonOK && test_docs[1].res == lwjsonERRJSON
+                 && test_docs[1].offset == 4 && test_docs[1].len == len - 4);
+        free(buff);
+    }
+
+#undef RUN_TEST
+
+    /* Print results */
+    printf("Parse many test result pass/fail: %d/%d\r\n\r\n", (int)test_passed, (int)test_failed);
+}
+
+#if !LWJSON_CFG_COMPACT_TOKEN
+
+/* Split root array to chunks, parse them separately and join them */
+static lwjsonr_t
+prv_parse_array_parts(lwjson_t* lw, const char* json_str, size_t chunks) {
+    static lwjson_token_t part_tokens[4][16];
+    lwjson_t parts[4];
+    size_t offsets[4];
+    lwjsonr_t res;
+
+    res = lwjson_split_array(json_str, strlen(json_str), offsets, chunks);
+    for (size_t i = 0, start = 0; res == lwjsonOK && i < chunks; start = offsets[i++]) {
+        lwjson_init(&parts[i], part_tokens[i], LWJSON_ARRAYSIZE(part_tokens[i]));
+        res = lwjson_parse_array_part(&parts[i], &json_str[start], offsets[i] - start);
+    }
+    if (res == lwjsonOK) {
+        lwjson_init(lw, NULL, 0);
+        res = lwjson_join_array(lw, parts, chunks);
+    }
+    return res;
+}
+
+#endif /* !LWJSON_CFG_COMPACT_TOKEN */
+
+/* Test parsing of root array in chunks */
+static void
+test_parse_array_parts(void) {
+    size_t test_failed = 0, test_passed = 0, offsets[3];
+    const char* json_str = " [{\"a\":\"x,]\"}, 1, [2, 3], {\"b\":[4, {\"c\":5}]}, true, \"s\", null, [] ] ";
+#if !LWJSON_CFG_COMPACT_TOKEN
+    static lwjson_token_t part_tokens[64];
+    lwjson_t parts[LWJSON_ARRAYSIZE(offsets)], lw;
+    const lwjson_token_t* t;
+    size_t used = 0, cnt;
+#endif /* !LWJSON_CFG_COMPACT_TOKEN */
+
+    printf("---\r\nTest JSON parse array parts..\r\n");
+
+#define RUN_TEST(c)                                                                                                    \
+    if ((c)) {                                                                                                         \
+        ++test_passed;                                                                                                 \
+    } else {                                                                                                           \
+        ++test_failed;                                                                                                 \
+        printf("Test failed on line %d\r\n", __LINE__);                                                                \
+    }
+
+    /* Chunks end at commas between elements, last one at closing bracket */
+    RUN_TEST(lwjson_split_array(json_str, strlen(json_str), offsets, LWJSON_ARRAYSIZE(offsets)) == lwjsonOK
+             && offsets[0] == 24 && offsets[1] == 50 && offsets[2] == 66);
+    RUN_TEST(lwjson_split_array("[1, [2, 3], 4]", 14, offsets, LWJSON_ARRAYSIZE(offsets)) == lwjsonOK
+             && offsets[0] == 10 && offsets[1] == 10 && offsets[2] == 13);
+    RUN_TEST(lwjson_split_array("[1, 2", 5, offsets, LWJSON_ARRAYSIZE(offsets)) == lwjsonERRJSON);
+    RUN_TEST(lwjson_split_array("[1] 2", 5, offsets, LWJSON_ARRAYSIZE(offsets)) == lwjsonERRJSON);
+    RUN_TEST(lwjson_split_array("{\"a\":1}", 7, offsets, LWJSON_ARRAYSIZE(offsets)) == lwjsonERRJSON);
+
+#if !LWJSON_CFG_COMPACT_TOKEN
+    /* Parse chunks separately and join them to single tree */
+    RUN_TEST(lwjson_split_array(json_str, strlen(json_str), offsets, LWJSON_ARRAYSIZE(offsets)) == lwjsonOK);
+    for (size_t i = 0, start = 0; i < LWJSON_ARRAYSIZE(offsets); start = offsets[i++]) {
+        lwjson_init(&parts[i], &part_tokens[used], LWJSON_ARRAYSIZE(part_tokens) - used);
+        RUN_TEST(lwjson_parse_array_part(&parts[i], &json_str[start], offsets[i] - start) == lwjsonOK);
+        used += lwjson_get_tokens_used(&parts[i]) - 1;
+    }
+    lwjson_init(&lw, NULL, 0);
+    RUN_TEST(lwjson_join_array(&lw, parts, LWJSON_ARRAYSIZE(parts)) == lwjsonOK);
+    RUN_TEST(lwjson_parse(&lwjson, json_str) == lwjsonOK
+             && lwjson_get_tokens_used(&lw) == lwjson_get_tokens_used(&lwjson));
+    RUN_TEST((t = lwjson_find(&lw, "#0.a")) != NULL && lwjson_string_compare(t, "x,]"));
+    RUN_TEST((t = lwjson_find(&lw, "#3.b.#1.c")) != NULL && lwjson_get_val_int(t) == 5);
+    RUN_TEST((t = lwjson_find(&lw, "#7")) != NULL && t->type == LWJSON_TYPE_ARRAY && lwjson_find(&lw, "#8") == NULL);
+    cnt = 0;
+    for (t = lwjson_get_first_child(lwjson_get_first_token(&lw)); t != NULL; t = lwjson_get_next(t)) {
+        ++cnt;
+    }
+    RUN_TEST(cnt == 8);
+
+    /* Chunk cannot close root array */
+    RUN_TEST(lwjson_parse_array_part(&parts[0], "[1]", 3) == lwjsonERRJSON);
+    RUN_TEST(lwjson_parse_array_part(&parts[0], "{}", 2) == lwjsonERRJSON);
+
+    /* Result does not depend on number of chunks, and is the same as from single parse */
+    {
+        static const char* const json_strs[] = {"[1}", "[{\"a\":1]}", "[,1]", "[ , 1, 2]", "[1,,2]",
+                                                "[[1],,[2]]", "[1,]", "[1, [2}, 3]", "[1, [2]", "[1, {}, [], \"x\"]"};
+
+        for (size_t i = 0; i < LWJSON_ARRAYSIZE(json_strs); ++i) {
+            uint8_t is_ok = lwjson_parse(&lwjson, json_strs[i]) == lwjsonOK;
+
+            for (size_t chunks = 1; chunks <= 4; ++chunks) {
+                RUN_TEST((prv_parse_array_parts(&lw, json_strs[i], chunks) == lwjsonOK) == is_ok);
+            }
+        }
+        RUN_TEST(lwjson_split_array("[1}", 3, offsets, LWJSON_ARRAYSIZE(offsets)) == lwjsonERRJSON);
+        RUN_TEST(lwjson_parse(&lwjson, "[1, [2]") == lwjsonERRJSON);
+    }
+#endif /* !LWJSON_CFG_COMPACT_TOKEN */
+
+#undef RUN_TEST
+
+    /* Print results */
+    printf("Parse array parts test result pass/fail: %d/%d\r\n\r\n", (int)test_passed, (int)test_failed);
+}
+
+#if LWJSON_CFG_SELECTIVE
+
+/* Test selective parsing */
+static void
+test_parse_selective(void) {
+    size_t test_failed = 0, test_passed = 0, full_cnt;
+    lwjson_path_t paths[4];
+    const lwjson_token_t* t;
+    const char* json_str = "{\"a\":{\"x\":[1,{\"y\":\"s\\\"}]\"}],\"big\":[[1,2],{\"q\":[3]}]},"
+                           "\"b\":[10,20,{\"c\":30},40],\"d\":\"}{\",\"e\":[{\"f\":1},{\"g\":2},{\"f\":3}]}";
+
+    printf("---\r\nTest JSON parse selective..\r\n");
+
+#define RUN_TEST(c)                                                                                                    \
+    if ((c)) {                                                                                                         \
+        ++test_passed;                                                                                                 \
+    } else {                                                                                                           \
+        ++test_failed;                                                                                                 \
+        printf("Test failed on line %d\r\n", __LINE__);                                                                \
+    }
+
+    RUN_TEST(lwjson_parse(&lwjson, json_str) == lwjsonOK);
+    full_cnt = lwjson_get_tokens_used(&lwjson);
+    RUN_TEST(lwjson_path_compile("a.x", &paths[0]) == lwjsonOK && lwjson_path_compile("b.#2.c", &paths[1]) == lwjsonOK
+             && lwjson_path_compile("e.#.f", &paths[2]) == lwjsonOK
+             && lwjson_path_compile("nokey.z", &paths[3]) == lwjsonOK);
+
+    /* Only values on selected paths have tokens */
+    RUN_TEST(lwjson_parse_selective(&lwjson, json_str, strlen(json_str), paths, LWJSON_ARRAYSIZE(paths)) == lwjsonOK
+             && lwjson_get_tokens_used(&lwjson) < full_cnt);
+    RUN_TEST((t = lwjson_find(&lwjson, "a.x.#1.y")) != NULL && t->type == LWJSON_TYPE_STRING
+             && lwjson_get_val_string_length(t) == 5);
+    RUN_TEST((t = lwjson_find(&lwjson, "a.x.#0")) != NULL && lwjson_get_val_int(t) == 1);
+    RUN_TEST((t = lwjson_find(&lwjson, "b.#2.c")) != NULL && lwjson_get_val_int(t) == 30);
+    RUN_TEST((t = lwjson_find(&lwjson, "e.#.f")) != NULL && lwjson_get_val_int(t) == 1);
+    RUN_TEST((t = lwjson_find(&lwjson, "e.#2.f")) != NULL && lwjson_get_val_int(t) == 3);
+    RUN_TEST((t = lwjson_find(&lwjson, "b.#0")) != NULL && t->type == LWJSON_TYPE_SKIPPED);
+    RUN_TEST(lwjson_find(&lwjson, "b.#3") == NULL);
+    RUN_TEST(lwjson_find(&lwjson, "a.big") == NULL);
+    RUN_TEST(lwjson_find(&lwjson, "d") == NULL);
+    RUN_TEST(lwjson_find(&lwjson, "e.#1.g") == NULL);
+
+    /* Empty path selects everything */
+    memset(&paths[3], 0x00, sizeof(paths[3]));
+    RUN_TEST(lwjson_parse_selective(&lwjson, json_str, strlen(json_str), paths, LWJSON_ARRAYSIZE(paths)) == lwjsonOK
+             && lwjson_get_tokens_used(&lwjson) == full_cnt);
+
+    /* Skipped values are still checked for strings and brackets */
+    RUN_TEST(lwjson_parse_selective(&lwjson, "{\"z\":[1,2,\"a\":1}", 16, paths, 1) == lwjsonERRJSON);
+    RUN_TEST(lwjson_parse_selective(&lwjson, "{\"z\":\"abc,\"a\":1}", 16, paths, 1) != lwjsonOK);
+    RUN_TEST(lwjson_parse_selective(&lwjson, "{\"z\":1 2,\"a\":1}", 15, paths, 1) == lwjsonERRJSON);
+    RUN_TEST(lwjson_parse_selective(&lwjson, json_str, strlen(json_str), paths, 65) == lwjsonERRPAR);
+
+    /* Skipped value spanning over several 64-byte blocks */
+    json_str = "{\"z\":[1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, {\"s\":\"]}\\\"\"},"
+               "[21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, 36, 37, 38, 39, 40]],\"a\":1}";
+    RUN_TEST(lwjson_path_compile("a", &paths[0]) == lwjsonOK
+             && lwjson_parse_selective(&lwjson, json_str, strlen(json_str), paths, 1) == lwjsonOK
+             && (t = lwjson_find(&lwjson, "a")) != NULL && lwjson_get_val_int(t) == 1 && lwjson_find(&lwjson, "z") == NULL);
+    RUN_TEST(lwjson_parse_selective(&lwjson, json_str, strlen(json_str) - 8, paths, 1) == lwjsonERRJSON);
+
+#undef RUN_TEST
+
+    /* Print results */
+    printf("Parse selective test result pass/fail: %d/%d\r\n\r\n", (int)test_passed, (int)test_failed);
+}
+
+#endif /* LWJSON_CFG_SELECTIVE */
+
+#if LWJSON_CFG_INSITU
+
+/* Test in-situ parsing */
+static void
+test_parse_insitu(void) {
+    size_t test_failed = 0, test_passed = 0, len;
+    const lwjson_token_t* t;
+    const char *str, *json_str = "{\"k\\u00e9y\":\"a\\n\\\"b\\\\\",\"plain\":\"xyz\","
+                                 "\"arr\":[\"\",\"\\u20ac\"],\"n\":12}";
+    char data[128];
+
+    printf("---\r\nTest JSON parse in-situ..\r\n");
+
+#define RUN_TEST(c)                                                                                                    \
+    if ((c)) {                                                                                                         \
+        ++test_passed;                                                                                                 \
+    } else {                                                                                                           \
+        ++test_failed;                                                                                                 \
+        printf("Test failed on line %d\r\n", __LINE__);                                                                \
+    }
+
+    strcpy(data, json_str);
+    RUN_TEST(lwjson_parse_insitu(&lwjson, data, strlen(data)) == lwjsonOK);
+
+    /* Names and string values are decoded and NULL-terminated */
+    RUN_TEST((t = lwjson_find(&lwjson, "k\xC3\xA9y")) != NULL && !lwjson_get_val_string_escaped(t));
+    RUN_TEST((str = lwjson_get_name(&lwjson, t, &len)) != NULL && len == 4 && strcmp(str, "k\xC3\xA9y") == 0);
+    RUN_TEST((str = lwjson_get_val_string_ex(&lwjson, t, &len)) != NULL && len == 5 && strcmp(str, "a\n\"b\\") == 0);
+    RUN_TEST(lwjson_get_val_string_decoded(&lwjson, t, NULL, 0, &len) == str && len == 5);
+    RUN_TEST((t = lwjson_find(&lwjson, "plain")) != NULL
+             && strcmp(lwjson_get_val_string_ex(&lwjson, t, NULL), "xyz") == 0);
+    RUN_TEST((t = lwjson_find(&lwjson, "arr.#0")) != NULL
+             && strcmp(lwjson_get_val_string_ex(&lwjson, t, NULL), "") == 0);
+    RUN_TEST((t = lwjson_find(&lwjson, "arr.#1")) != NULL
+             && strcmp(lwjson_get_val_string_ex(&lwjson, t, NULL), "\xE2\x82\xAC") == 0);
+    RUN_TEST((t = lwjson_find(&lwjson, "n")) != NULL && lwjson_get_val_int(t) == 12);
+
+    /* Invalid input */
+    strcpy(data, "{\"a\":\"b\\x\"}");
+    RUN_TEST(lwjson_parse_insitu(&lwjson, data, strlen(data)) == lwjsonERRJSON);
+    RUN_TEST(lwjson_parse_insitu(&lwjson, NULL, 1) == lwjsonERRPAR);
+
+#undef RUN_TEST
+
+    /* Print results */
+    printf("Parse in-situ test result pass/fail: %d/%d\r\n\r\n", (int)test_passed, (int)test_failed);
+}
+
+#endif /* LWJSON_CFG_INSITU */
+
+/* Test parsing of input with zero padding */
+static void
+test_parse_padded(void) {
+    size_t test_failed = 0, test_passed = 0, len;
+    const lwjson_token_t* t;
+    const char* str;
+    static const char json_str[] = "{\"a\":\"x\0y\",\"n\":12345678,"
+                                   "\"long\":\"0123456789012345678901234567890123456789012345678901234567890123\"}";
+    char data[128 + LWJSON_PADDING];
+
+    printf("---\r\nTest JSON parse padded..\r\n");
+
+#define RUN_TEST(c)                                                                                                    \
+    if ((c)) {                                                                                                         \
+        ++test_passed;                                                                                                 \
+    } else {                                                                                                           \
+        ++test_failed;                                                                                                 \
+        printf("Test failed on line %d\r\n", __LINE__);                                                                \
+    }
+
+    /* NULL character is part of the string */
+    memset(data, 0x00, sizeof(data));
+    memcpy(data, json_str, sizeof(json_str) - 1);
+    RUN_TEST(lwjson_parse_padded(&lwjson, data, sizeof(json_str) - 1) == lwjsonOK);
+    RUN_TEST((t = lwjson_find(&lwjson, "a")) != NULL && (str = lwjson_get_val_string_ex(&lwjson, t, &len)) != NULL
+             && len == 3 && memcmp(str, "x\0y", 3) == 0);
+    RUN_TEST((t = lwjson_find(&lwjson, "long")) != NULL && lwjson_get_val_string_length(t) == 64);
+    RUN_TEST((t = lwjson_find(&lwjson, "n")) != NULL && lwjson_get_val_int(t) == 12345678);
+
+    /* NULL character outside of strings, and incomplete input followed by padding */
+    memset(data, 0x00, sizeof(data));
+    memcpy(data, "[1,\0 2]", 7);
+    RUN_TEST(lwjson_parse_padded(&lwjson, data, 7) == lwjsonERRJSON);
+    memset(data, 0x00, sizeof(data));
+    memcpy(data, "[\"abc", 5);
+    RUN_TEST(lwjson_parse_padded(&lwjson, data, 5) == lwjsonERRJSON);
+    RUN_TEST(lwjson_parse_padded(&lwjson, data, 3) == lwjsonERRJSON);
+    RUN_TEST(lwjson_parse_padded(&lwjson, NULL, 1) == lwjsonERRPAR);
+
+#undef RUN_TEST
+
+    /* Print results */
+    printf("Parse padded test result pass/fail: %d/%d\r\n\r\n", (int)test_passed, (int)test_failed);
+}
+
+#if LWJSON_CFG_QUERY
+
+/**
+ * \brief           Values of tokens reported by \ref lwjson_query
+ */
+typedef struct {
+    lwjson_int_t vals[16]; /*!< Integer values of matched tokens */
+    size_t cnt;            /*!< Number of matched tokens */
+} test_query_result_t;
+
+/* Callback for query test */
+static void
+prv_query_callback(lwjson_t* lw, const lwjson_token_t* token, void* user_data) {
+    test_query_result_t* res = user_data;
+
+    (void)lw;
+    if (res->cnt < LWJSON_ARRAYSIZE(res->vals)) {
+        res->vals[res->cnt] = lwjson_get_val_int(token);
+    }
+    ++res->cnt;
+}
+
+/* Run query and compare integer values of matched tokens */
+static uint8_t
+prv_query_check(const char* query_str, const lwjson_int_t* vals, size_t cnt) {
+    lwjson_query_t query;
+    test_query_result_t res = {0};
+
+    if (lwjson_query_compile(query_str, &query) != lwjsonOK
+        || lwjson_query(&lwjson, NULL, &query, prv_query_callback, &res) != lwjsonOK || res.cnt != cnt) {
+        return 0;
+    }
+    for (size_t i = 0; i < cnt; ++i) {
+        if (res.vals[i] != vals[i]) {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* Test query engine */
+static void
+test_query(void) {
+    size_t test_failed = 0, test_passed = 0;
+    lwjson_query_t query;
+    const char* json_str = "{\"store\":{\"book\":[{\"price\":8,\"tags\":[1,2]},{\"price\":12},{\"price\":9,\"id\":3}],"
+                           "\"bike\":{\"price\":20}},\"price\":1}";
+
+    printf("---\r\nTest JSON query..\r\n");
+
+#define RUN_TEST(c)                                                                                                    \
+    if ((c)) {                                                                                                         \
+        ++test_passed;                                                                                                 \
+    } else {                                                                                                           \
+        ++test_failed;                                                                                                 \
+        printf("Test failed on line %d\r\n", __LINE__);                                                                \
+    }
+#define RUN_QUERY(q, ...)                                                                                              \
+    do {                                                                                                               \
+        const lwjson_int_t vals[] = {0, __VA_ARGS__};                                                                  \
+        RUN_TEST(prv_query_check((q), &vals[1], LWJSON_ARRAYSIZE(vals) - 1));                                          \
+    } while (0)
+
+    if (lwjson_parse(&lwjson, json_str) != lwjsonOK) {
+        printf("Could not parse JSON string..\r\n");
+        return;
+    }
+
+    /* Matches are reported in document order */
+    RUN_QUERY("$.store.book[*].price", 8, 12, 9);
+    RUN_QUERY("$.store.book.*.price", 8, 12, 9);
+    RUN_QUERY("$..price", 8, 12, 9, 20, 1);
+    RUN_QUERY("$..*..price", 8, 12, 9, 20);
+    RUN_QUERY("$.store.*.price", 20);
+    RUN_QUERY("$['store'][\"bike\"].price", 20);
+    RUN_QUERY("$..tags[*]", 1, 2);
+    RUN_QUERY("$..book[1]['price']", 12);
+    RUN_QUERY("$.store.book[-1].price", 9);
+    RUN_QUERY("$.store.book[0:2].price", 8, 12);
+    RUN_QUERY("$.store.book[::2].price", 8, 9);
+    RUN_QUERY("$.store.book[-2:].price", 12, 9);
+    RUN_QUERY("$.store.book[1:-1].price", 12);
+    RUN_QUERY("$..[0]", 0, 1);
+    RUN_QUERY("$..id", 3);
+    RUN_QUERY("$.price", 1);
+    RUN_QUERY("$", 0);
+    RUN_TEST(prv_query_check("$.nokey", NULL, 0));
+    RUN_TEST(prv_query_check("$.store.book[3]", NULL, 0));
+    RUN_TEST(prv_query_check("$.store.book[-4]", NULL, 0));
+    RUN_TEST(prv_query_check("$.price.x", NULL, 0));
+
+    /* Invalid queries */
+    RUN_TEST(lwjson_query_compile("store", &query) == lwjsonERRPAR);
+    RUN_TEST(lwjson_query_compile("$.", &query) == lwjsonERRPAR);
+    RUN_TEST(lwjson_query_compile("$store", &query) == lwjsonERRPAR);
+    RUN_TEST(lwjson_query_compile("$['store'", &query) == lwjsonERRPAR);
+    RUN_TEST(lwjson_query_compile("$[a]", &query) == lwjsonERRPAR);
+    RUN_TEST(lwjson_query_compile("$[]", &query) == lwjsonERRPAR);
+    RUN_TEST(lwjson_query_compile("$[1:2:0]", &query) == lwjsonERRPAR);
+    RUN_TEST(lwjson_query_compile("$[99999999999]", &query) == lwjsonERRPAR);
+    RUN_TEST(lwjson_query_compile("$.a..", &query) == lwjsonERRPAR);
+    RUN_TEST(lwjson_query_compile("$.a.b.c.d.e.f.g.h.i", &query) == lwjsonERRMEM);
+#undef RUN_QUERY
+#undef RUN_TEST
+
+    /* Print results */
+    printf("Query test result pass/fail: %d/%d\r\n\r\n", (int)test_passed, (int)test_failed);
+}
+
+#endif /* LWJSON_CFG_QUERY */
+
+#if LWJSON_CFG_TAPE
+/* Test tape output format */
+static void
+test_tape(void) {
+    size_t test_failed = 0, test_passed = 0;
+    lwjson_tape_word_t tape[256];
+    lwjson_tape_t tobj;
+    const lwjson_tape_word_t* w;
+    const char* str;
+    size_t len;
+    const char* json_str = "\
+    {\
+        \"my_arr\":[\
+            {\"num\":1,\"str\":\"first_entry\"},\
+            {\"num\":2.5,\"str\":\"second_entry\"},\
+            [\"abc\", \"def\"],\
+            [true, false, null],\
+            []\
+        ],\
+        \"my_obj\": {\
+            \"arr\": [[1, 2, 3], [{\"my_key\":\"my_text\"}]],\
+            \"ustr\":\"\\t\\u1234abc\"\
+        }\
+    }\
+    ";
+
+    printf("---\r\nTest JSON tape..\r\n");
+
+#define RUN_TEST(c)                                                                                                    \
+    if ((c)) {                                                                                                         \
+        ++test_passed;                                                                                                 \
+    } else {                                                                                                           \
+        ++test_failed;                                                                                                 \
+        printf("Test failed on line %d\r\n", __LINE__);                                                                \
+    }
+
+    lwjson_tape_init(&tobj, tape, LWJSON_ARRAYSIZE(tape));
+    RUN_TEST(lwjson_tape_parse(&tobj, json_str) == lwjsonOK);
+    RUN_TEST((w = lwjson_tape_find(&tobj, "my_arr")) != NULL && lwjson_tape_get_type(w) == LWJSON_TYPE_ARRAY);
+    RUN_TEST((w = lwjson_tape_find(&tobj, "my_arr.#")) == NULL);
+    RUN_TEST((w = lwjson_tape_find(&tobj, "my_arr.#0.num")) != NULL && lwjson_tape_get_val_int(w) == 1);
+    RUN_TEST((w = lwjson_tape_find(&tobj, "my_arr.#1.num")) != NULL && lwjson_tape_get_val_real(w) == 2.5);
+    RUN_TEST((w = lwjson_tape_find(&tobj, "my_arr.#1.str")) != NULL
+             && (str = lwjson_tape_get_val_string(&tobj, w, &len)) != NULL && len == 12
+             && strncmp(str, "second_entry", 12) == 0);
+    RUN_TEST((w = lwjson_tape_find(&tobj, "my_arr.#2.#1")) != NULL
+             && (str = lwjson_tape_get_val_string(&tobj, w, &len)) != NULL && strncmp(str, "def", len) == 0);
+    RUN_TEST((w = lwjson_tape_find(&tobj, "my_arr.#3.#0")) != NULL && lwjson_tape_get_type(w) == LWJSON_TYPE_TRUE);
+    RUN_TEST((w = lwjson_tape_find(&tobj, "my_arr.#3.#2")) != NULL && lwjson_tape_get_type(w) == LWJSON_TYPE_NULL);
+    RUN_TEST((w = lwjson_tape_find(&tobj, "my_arr.#4")) != NULL && lwjson_tape_get_first_child(w) == NULL
+             && lwjson_tape_get_next(w) == NULL);
+    RUN_TEST((w = lwjson_tape_find(&tobj, "my_arr.#5")) == NULL);
+    RUN_TEST((w = lwjson_tape_find(&tobj, "my_obj.arr.#.#.my_key")) != NULL
+             && (str = lwjson_tape_get_val_string(&tobj, w, &len)) != NULL && strncmp(str, "my_text", len) == 0);
+    RUN_TEST((w = lwjson_tape_find(&tobj, "my_obj")) != NULL && (w = lwjson_tape_find_ex(&tobj, w, "arr.#0.#2")) != NULL
+             && lwjson_tape_get_val_int(w) == 3);
+
+    /* Names and links, whole subtree is skipped */
+    RUN_TEST((w = lwjson_tape_find(&tobj, "my_arr")) != NULL && (w = lwjson_tape_get_next(w)) != NULL
+             && (str = lwjson_tape_get_name(&tobj, w, &len)) != NULL && strncmp(str, "my_obj", len) == 0);
+    RUN_TEST((w = lwjson_tape_find(&tobj, "my_obj.ustr")) != NULL && lwjson_tape_get_next(w) == NULL
+             && lwjson_tape_get_val_string(&tobj, w, &len) != NULL && len == 11);
+    RUN_TEST((w = lwjson_tape_find(&tobj, "my_arr.#0")) != NULL && lwjson_tape_get_name(&tobj, w, NULL) == NULL);
+    RUN_TEST((w = lwjson_tape_get_root(&tobj)) != NULL && (w = lwjson_tape_get_first_child(w)) != NULL
+             && (w = lwjson_tape_get_first_child(w)) != NULL && (w = lwjson_tape_get_next(w)) != NULL
+             && (w = lwjson_tape_get_next(w)) != NULL && (w = lwjson_tape_get_first_child(w)) != NULL
+             && (str = lwjson_tape_get_val_string(&tobj, w, &len)) != NULL && strncmp(str, "abc", len) == 0);
+
+    /* Invalid input and tape size */
+    RUN_TEST(lwjson_tape_parse(&tobj, "{\"a\":1,]") == lwjsonERRJSON);
+    RUN_TEST(lwjson_tape_parse(&tobj, "[1,2") == lwjsonERRJSON);
+    RUN_TEST(lwjson_tape_parse(&tobj, "[1] 2") != lwjsonOK && lwjson_tape_get_root(&tobj) == NULL);
+    RUN_TEST(lwjson_tape_parse(&tobj, "[12345678901234567890]") == lwjsonERRNUMRANGE);
+    lwjson_tape_init(&tobj, tape, 5);
+    RUN_TEST(lwjson_tape_parse(&tobj, "[1,2]") == lwjsonERRMEM);
+    RUN_TEST(lwjson_tape_parse(&tobj, "[1]") == lwjsonOK && tobj.tape_used == 5);
+
+#undef RUN_TEST
+
+    /* Print results */
+    printf("Tape test result pass/fail: %d/%d\r\n\r\n", (int)test_passed, (int)test_failed);
+}
+#endif /* LWJSON_CFG_TAPE */
+
+#if LWJSON_CFG_ON_DEMAND
+/* Test on-demand iterator */
+static void
+test_on_demand(void) {
+    size_t test_failed = 0, test_passed = 0, cnt;
+    lwjson_od_t od;
+    lwjson_int_t int_num;
+    lwjson_real_t real_num;
+    lwjson_type_t type;
+    const char* str;
+    size_t len;
+    uint8_t b;
+    const char* json_str = "\
+    {\
+        \"id\": 1234,\
+        \"skip\": {\"a\": [1, {\"b\": \"}]\"}, [[]]], \"c\": null},\
+        \"name\": \"my_name\",\
+        \"vals\": [1.5, true, \"x\", false, -3],\
+        \"last\": {\"x\": 1, \"y\": 2}\
+    }\
+    ";
+
+    printf("---\r\nTest JSON on-demand iterator..\r\n");
+
+#define RUN_TEST(c)                                                                                                    \
+    if ((c)) {                                                                                                         \
+        ++test_passed;                                                                                                 \
+    } else {                                                                                                           \
+        ++test_failed;                                                                                                 \
+        printf("Test failed on line %d\r\n", __LINE__);                                                                \
+    }
+
+    /* Read fields in document order, other values are skipped */
+    RUN_TEST(lwjson_od_init(&od, json_str, strlen(json_str)) == lwjsonOK);
+    RUN_TEST(lwjson_od_get_type(&od, &type) == lwjsonOK && type == LWJSON_TYPE_OBJECT);
+    RUN_TEST(lwjson_od_enter(&od) == lwjsonOK);
+    RUN_TEST(lwjson_od_find_field(&od, "id") == lwjsonOK && lwjson_od_get_int(&od, &int_num) == lwjsonOK
+             && int_num == 1234);
+    RUN_TEST(lwjson_od_find_field(&od, "name") == lwjsonOK && lwjson_od_get_real(&od, &real_num) == lwjsonERRPAR
+             && lwjson_od_get_string(&od, &str, &len) == lwjsonOK && len == 7 && strncmp(str, "my_name", 7) == 0);
+    RUN_TEST(lwjson_od_find_field(&od, "vals") == lwjsonOK && lwjson_od_enter(&od) == lwjsonOK);
+    RUN_TEST(lwjson_od_next(&od, &str, &len) == lwjsonOK && str == NULL
+             && lwjson_od_get_real(&od, &real_num) == lwjsonOK && real_num == (lwjson_real_t)1.5);
+    RUN_TEST(lwjson_od_next(&od, NULL, NULL) == lwjsonOK && lwjson_od_get_bool(&od, &b) == lwjsonOK && b == 1);
+    RUN_TEST(lwjson_od_next(&od, NULL, NULL) == lwjsonOK && lwjson_od_get_type(&od, &type) == lwjsonOK
+             && type == LWJSON_TYPE_STRING);
+    RUN_TEST(lwjson_od_next(&od, NULL, NULL) == lwjsonOK && lwjson_od_next(&od, NULL, NULL) == lwjsonOK
+             && lwjson_od_get_int(&od, &int_num) == lwjsonOK && int_num == -3);
+    RUN_TEST(lwjson_od_next(&od, NULL, NULL) == lwjsonODEND);
+    RUN_TEST(lwjson_od_next(&od, &str, &len) == lwjsonOK && len == 4 && strncmp(str, "last", 4) == 0);
+    RUN_TEST(lwjson_od_enter(&od) == lwjsonOK && lwjson_od_find_field(&od, "x") == lwjsonOK
+             && lwjson_od_exit(&od) == lwjsonOK);
+    RUN_TEST(lwjson_od_next(&od, NULL, NULL) == lwjsonODEND && od.depth == 0);
+
+    /* Field not found leaves the object */
+    RUN_TEST(lwjson_od_init(&od, json_str, strlen(json_str)) == lwjsonOK && lwjson_od_enter(&od) == lwjsonOK
+             && lwjson_od_find_field(&od, "name") == lwjsonOK && lwjson_od_find_field(&od, "id") == lwjsonODEND
+             && od.depth == 0);
+
+    /* Iterate all elements, nested values are skipped */
+    RUN_TEST(lwjson_od_init(&od, json_str, strlen(json_str)) == lwjsonOK && lwjson_od_enter(&od) == lwjsonOK);
+    for (cnt = 0; lwjson_od_next(&od, NULL, NULL) == lwjsonOK; ++cnt) {}
+    RUN_TEST(cnt == 5 && !od.flags.error);
+    RUN_TEST(lwjson_od_init(&od, json_str, strlen(json_str)) == lwjsonOK && lwjson_od_skip(&od) == lwjsonOK);
+
+    /* Invalid data is detected when reached, error is kept */
+    RUN_TEST(lwjson_od_init(&od, "[1, 2,, 3]", 10) == lwjsonOK && lwjson_od_enter(&od) == lwjsonOK
+             && lwjson_od_next(&od, NULL, NULL) == lwjsonOK && lwjson_od_next(&od, NULL, NULL) == lwjsonOK
+             && lwjson_od_next(&od, NULL, NULL) == lwjsonERRJSON && lwjson_od_next(&od, NULL, NULL) == lwjsonERRJSON);
+    RUN_TEST(lwjson_od_init(&od, "[1, 2,]", 7) == lwjsonOK && lwjson_od_skip(&od) == lwjsonERRJSON);
+    RUN_TEST(lwjson_od_init(&od, "{\"a\":[1}", 9) == lwjsonOK && lwjson_od_skip(&od) == lwjsonERRJSON);
+    RUN_TEST(lwjson_od_init(&od, "{\"a\":1", 7) == lwjsonOK && lwjson_od_skip(&od) == lwjsonERRJSON);
+    RUN_TEST(lwjson_od_init(&od, "[123456789012345678901]", 23) == lwjsonOK
+             && lwjson_od_skip(&od) == lwjsonERRNUMRANGE);
+
+#undef RUN_TEST
+
+    /* Print results */
+    printf("On-demand test result pass/fail: %d/%d\r\n\r\n", (int)test_passed, (int)test_failed);
+}
+#endif /* LWJSON_CFG_ON_DEMAND */
+
+#if LWJSON_CFG_ARENA
+/* Test growable arena of tokens */
+static void
+test_arena(void) {
+    size_t test_failed = 0, test_passed = 0, blk_cnt = 0, n = 0;
+    lwjson_token_t arena_tokens[4];
+    lwjson_arena_blk_t* blk;
+    const lwjson_token_t* t;
+    lwjson_t lw;
+    static char json_str[8192];
+
+    printf("---\r\nTest JSON token arena..\r\n");
+
+#define RUN_TEST(c)                                                                                                    \
+    if ((c)) {                                                                                                         \
+        ++test_passed;                                                                                                 \
+    } else {                                                                                                           \
+        ++test_failed;                                                                                                 \
+        printf("Test failed on line %d\r\n", __LINE__);                                                                \
+    }
+
+    /* Array of 1000 numbers needs more tokens than the array has */
+    json_str[n++] = '[';
+    for (size_t i = 0; i < 1000; ++i) {
+        n += (size_t)sprintf(&json_str[n], "%s%d", i > 0 ? "," : "", (int)i);
+    }
+    json_str[n++] = ']';
+    json_str[n] = '\0';
+
+    RUN_TEST(lwjson_init(&lw, arena_tokens, LWJSON_ARRAYSIZE(arena_tokens)) == lwjsonOK);
+    RUN_TEST(lwjson_parse(&lw, json_str) == lwjsonOK && lwjson_get_tokens_used(&lw) == 1001);
+    RUN_TEST((t = lwjson_find(&lw, "#0")) != NULL && t == &arena_tokens[0] && lwjson_get_val_int(t) == 0);
+    RUN_TEST((t = lwjson_find(&lw, "#999")) != NULL && lwjson_get_val_int(t) == 999);
+    for (blk = lw.arena_first; blk != NULL; blk = blk->next) {
+        ++blk_cnt;
+    }
+    RUN_TEST(blk_cnt == 5 && lw.arena_len == 4 + 64 + 68 + 136 + 272 + 544);
+
+    /* Blocks are kept and reused for next parse */
+    RUN_TEST(lwjson_free(&lw) == lwjsonOK && lwjson_parse(&lw, json_str) == lwjsonOK && lw.arena_len == 1088);
+    RUN_TEST((t = lwjson_find(&lw, "#500")) != NULL && lwjson_get_val_int(t) == 500);
+    RUN_TEST(lwjson_parse(&lw, "[1,2,3]") == lwjsonOK && lw.arena_cur == NULL);
+    RUN_TEST(lwjson_arena_release(&lw) == lwjsonOK && lw.arena_first == NULL && lw.arena_len == 4);
+
+    /* Instance without array of tokens */
+    RUN_TEST(lwjson_init(&lw, NULL, 0) == lwjsonOK && lwjson_parse(&lw, json_str) == lwjsonOK
+             && lwjson_get_tokens_used(&lw) == 1001);
+    RUN_TEST((t = lwjson_find(&lw, "#999")) != NULL && lwjson_get_val_int(t) == 999);
+    RUN_TEST(lwjson_arena_release(&lw) == lwjsonOK);
+
+#undef RUN_TEST
+
+    /* Print results */
+    printf("Arena test result pass/fail: %d/%d\r\n\r\n", (int)test_passed, (int)test_failed);
+}
+#endif /* LWJSON_CFG_ARENA */
+
+#if LWJSON_CFG_FILE
+/* Test parsing of files mapped to memory */
+static void
+test_parse_file(void) {
+    size_t test_failed = 0, test_passed = 0;
+    const char* json_str = "{\"name\":\"file\",\"values\":[1, 2, 3]}\n";
+    const char* path = "lwjson_test_file.json";
+    lwjson_stream_parser_t jsp;
+    const lwjson_token_t* t;
+    const char* str;
+    size_t len;
+    FILE* f;
+
+    printf("---\r\nTest JSON parse file..\r\n");
+
+#define RUN_TEST(c)                                                                                                    \
+    if ((c)) {                                                                                                         \
+        ++test_passed;                                                                                                 \
+    } else {                                                                                                           \
+        ++test_failed;                                                                                                 \
+        printf("Test failed on line %d\r\n", __LINE__);                                                                \
+    }
+
+    if ((f = fopen(path, "wb")) == NULL) {
+        printf("Cannot create test file\r\n");
+        return;
+    }
+    fputs(json_str, f);
+    fclose(f);
+
+    /* Strings refer directly to the mapped file */
+    RUN_TEST(lwjson_parse_file(&lwjson, path) == lwjsonOK && lwjson.file_data != NULL
+             && lwjson.file_len == strlen(json_str));
+    RUN_TEST((t = lwjson_find(&lwjson, "name")) != NULL && (str = lwjson_get_val_string_ex(&lwjson, t, &len)) != NULL
+             && len == 4 && strncmp(str, "file", 4) == 0 && str > (const char*)lwjson.file_data
+             && str < (const char*)lwjson.file_data + lwjson.file_len);
+    RUN_TEST((t = lwjson_find(&lwjson, "values.#2")) != NULL && lwjson_get_val_int(t) == 3);
+
+    /* Parse same file again, previous mapping is replaced */
+    RUN_TEST(lwjson_parse_file(&lwjson, path) == lwjsonOK && lwjson_find(&lwjson, "values.#0") != NULL);
+    RUN_TEST(lwjson_free(&lwjson) == lwjsonOK && lwjson.file_data == NULL && lwjson.file_len == 0);
+    RUN_TEST(lwjson_parse_file(&lwjson, "lwjson_missing_file.json") == lwjsonERR && lwjson.file_data == NULL);
+
+    /* Stream parser */
+    RUN_TEST(lwjson_stream_init(&jsp, NULL) == lwjsonOK && lwjson_stream_parse_file(&jsp, path) == lwjsonSTREAMDONE);
+
+    /* File with invalid JSON is unmapped */
+    if ((f = fopen(path, "wb")) != NULL) {
+        fputs("{\"a\":}", f);
+        fclose(f);
+    }
+    RUN_TEST(lwjson_parse_file(&lwjson, path) == lwjsonERRJSON && lwjson.file_data == NULL);
+
+    /* File ends with incomplete number, at the end of the last mapped page */
+    if ((f = fopen(path, "wb")) != NULL) {
+        fputc('[', f);
+        for (size_t i = 0; i < 65536 - 9; ++i) {
+            fputc(' ', f);
+        }
+        fputs("12345678", f);
+        fclose(f);
+    }
+    RUN_TEST(lwjson_parse_file(&lwjson, path) == lwjsonERRJSON && lwjson.file_data == NULL);
+    remove(path);
+
+#undef RUN_TEST
+
+    /* Print results */
+    printf("Parse file test result pass/fail: %d/%d\r\n\r\n", (int)test_passed, (int)test_failed);
+}
+#endif /* LWJSON_CFG_FILE */
+
+#if LWJSON_CFG_VALIDATE_UTF8
+/* Feed characters to stream parser, until first error */
+static lwjsonr_t
+prv_stream_feed(lwjson_stream_parser_t* jsp, const char* data, size_t len) {
+    lwjsonr_t res = lwjsonSTREAMWAITFIRSTCHAR;
+
+    for (size_t i = 0; i < len; ++i) {
+        res = lwjson_stream_parse(jsp, data[i]);
+        if (res != lwjsonSTREAMWAITFIRSTCHAR && res != lwjsonSTREAMINPROG && res != lwjsonSTREAMDONE) {
+            break;
+        }
+    }
+    return res;
+}
+
+/* Test UTF-8 validation of stream parser */
+static void
+test_stream_utf8(void) {
+    size_t test_failed = 0, test_passed = 0;
+    lwjson_stream_parser_t jsp;
+    char str[2 * LWJSON_CFG_STREAM_STRING_MAX_LEN];
+    size_t len;
+
+    printf("---\r\nTest JSON stream UTF-8..\r\n");
+
+#define RUN_TEST(exp_res, json_str)                                                                                    \
+    if (lwjson_stream_init(&jsp, NULL) == lwjsonOK                                                                     \
+        && prv_stream_feed(&jsp, (json_str), strlen(json_str)) == (exp_res)) {                                         \
+        ++test_passed;                                                                                                 \
+    } else {                                                                                                           \
+        ++test_failed;                                                                                                 \
+        printf("Test failed on line %d\r\n", __LINE__);                                                                \
+    }
+
+    RUN_TEST(lwjsonSTREAMDONE, "{\"k\xC3\xA9\":\"\xE2\x82\xAC \xF0\x9F\x98\x80 \xF4\x8F\xBF\xBF\"}");
+    RUN_TEST(lwjsonSTREAMDONE, "[\"\xC3\xA9\",\"\xEF\xBF\xBF\",\"\xED\x9F\xBF\"]");
+    RUN_TEST(lwjsonERRJSON, "{\"k\":\"\xC3\"}");             /* Truncated sequence */
+    RUN_TEST(lwjsonERRJSON, "{\"k\":\"\xC0\xAF\"}");         /* Overlong form */
+    RUN_TEST(lwjsonERRJSON, "{\"k\":\"\xE0\x9F\xBF\"}");     /* Overlong form */
+    RUN_TEST(lwjsonERRJSON, "{\"k\":\"\xF0\x8F\xBF\xBF\"}"); /* Overlong form */
+    RUN_TEST(lwjsonERRJSON, "{\"k\":\"\xED\xA0\x80\"}");     /* Surrogate */
+    RUN_TEST(lwjsonERRJSON, "[\"\xED\xBF\xBF\"]");           /* Surrogate */
+    RUN_TEST(lwjsonERRJSON, "{\"k\":\"\xF4\x90\x80\x80\"}"); /* Above U+10FFFF */
+    RUN_TEST(lwjsonERRJSON, "{\"k\xFF\":1}");                /* Invalid byte in property name */
+    RUN_TEST(lwjsonERRJSON, "[\"\x80\"]");                   /* Lone continuation */
+
+#undef RUN_TEST
+#define RUN_TEST(c)                                                                                                    \
+    if ((c)) {                                                                                                         \
+        ++test_passed;                                                                                                 \
+    } else {                                                                                                           \
+        ++test_failed;                                                                                                 \
+        printf("Test failed on line %d\r\n", __LINE__);                                                                \
+    }
+
+    /* Code point split between two feeds */
+    RUN_TEST(lwjson_stream_init(&jsp, NULL) == lwjsonOK
+             && prv_stream_feed(&jsp, "{\"k\":\"ab\xF0\x9F", 10) == lwjsonSTREAMINPROG
+             && prv_stream_feed(&jsp, "\x98\x80\"}", 4) == lwjsonSTREAMDONE);
+    RUN_TEST(lwjson_stream_init(&jsp, NULL) == lwjsonOK
+             && prv_stream_feed(&jsp, "{\"k\":\"ab\xF0\x9F", 10) == lwjsonSTREAMINPROG
+             && prv_stream_feed(&jsp, "\x98\"}", 3) == lwjsonERRJSON);
+
+    /* Code point split between two parts of string longer than the string buffer */
+    len = 0;
+    str[len++] = '[';
+    str[len++] = '"';
+    memset(&str[len], 'a', LWJSON_CFG_STREAM_STRING_MAX_LEN - 2);
+    len += LWJSON_CFG_STREAM_STRING_MAX_LEN - 2;
+    memcpy(&str[len], "\xE2\x82\xAC\"]", 5);
+    len += 5;
+    RUN_TEST(lwjson_stream_init(&jsp, NULL) == lwjsonOK && prv_stream_feed(&jsp, str, len) == lwjsonSTREAMDONE);
+    str[len - 3] = 'a';
+    RUN_TEST(lwjson_stream_init(&jsp, NULL) == lwjsonOK && prv_stream_feed(&jsp, str, len) == lwjsonERRJSON);
+
+#undef RUN_TEST
+
+    /* Print results */
+    printf("Stream UTF-8 test result pass/fail: %d/%d\r\n\r\n", (int)test_passed, (int)test_failed);
+}
+#endif /* LWJSON_CFG_VALIDATE_UTF8 */
+
 /**
  * \brief           Run all tests entry point
  */
 void
 test_run(void) {
-    /* Init LwJSON */
+    /* Init LwJSON, array of tokens is not cleared by the library */
+    memset(tokens, 0xFF, sizeof(tokens));
     lwjson_init(&lwjson, tokens, LWJSON_ARRAYSIZE(tokens));
+#if LWJSON_CFG_CHILD_INDEX
+    lwjson_set_index(&lwjson, tokens_index, LWJSON_ARRAYSIZE(tokens_index));
+#endif /* LWJSON_CFG_CHILD_INDEX */
+#if LWJSON_CFG_KEY_INDEX
+    lwjson_set_key_index(&lwjson, tokens_key_index, LWJSON_ARRAYSIZE(tokens_key_index));
+#endif /* LWJSON_CFG_KEY_INDEX */
 
     /* Test JSON parse */
     test_json_parse();
 
+    /* Test number of tokens */
+    test_parse_token_count();
+
+    /* Test number values */
+    test_json_number_values();
+
     /* Test find function */
     test_find_function();
 
     /* Parse input text and compare against expected data types */
     test_json_data_types();
+
+    /* Parse multiple documents */
+    test_parse_many();
+
+    /* Parse root array in chunks */
+    test_parse_array_parts();
+
+#if LWJSON_CFG_SELECTIVE
+    /* Parse values on selected paths only */
+    test_parse_selective();
+#endif /* LWJSON_CFG_SELECTIVE */
+
+#if LWJSON_CFG_INSITU
+    /* Parse writable input text in place */
+    test_parse_insitu();
+#endif /* LWJSON_CFG_INSITU */
+
+    /* Parse input text followed by zero padding */
+    test_parse_padded();
+
+#if LWJSON_CFG_QUERY
+    /* Query tokens with wildcards and recursive descent */
+    test_query();
+#endif /* LWJSON_CFG_QUERY */
+
+#if LWJSON_CFG_TAPE
+    /* Parse input text to the tape */
+    test_tape();
+#endif /* LWJSON_CFG_TAPE */
+
+#if LWJSON_CFG_ON_DEMAND
+    /* Iterate input text on demand */
+    test_on_demand();
+#endif /* LWJSON_CFG_ON_DEMAND */
+
+#if LWJSON_CFG_ARENA
+    /* Parse input text to growable arena of tokens */
+    test_arena();
+#endif /* LWJSON_CFG_ARENA */
+
+#if LWJSON_CFG_FILE
+    /* Parse file mapped to memory */
+    test_parse_file();
+#endif /* LWJSON_CFG_FILE */
+
+#if LWJSON_CFG_VALIDATE_UTF8
+    /* Validate UTF-8 strings in stream parser */
+    test_stream_utf8();
+#endif /* LWJSON_CFG_VALIDATE_UTF8 */
 }